@@ -0,0 +1,102 @@
+/**
+ * @file headless_example.cpp
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#include <MeshcatCpp/Material.h>
+#include <MeshcatCpp/Meshcat.h>
+#include <MeshcatCpp/MeshcatParams.h>
+#include <MeshcatCpp/Shape.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <msgpack.hpp>
+
+using Message = std::pair<std::string, std::string>;
+
+/**
+ * Get the type and the path of a message sent by Meshcat.
+ */
+Message unpack_message(std::string_view msg)
+{
+    Message message;
+    const msgpack::object_handle handle = msgpack::unpack(msg.data(), msg.size());
+    const msgpack::object& object = handle.get();
+    if (object.type != msgpack::type::MAP)
+    {
+        return message;
+    }
+
+    for (std::uint32_t i = 0; i < object.via.map.size; i++)
+    {
+        const msgpack::object_kv& entry = object.via.map.ptr[i];
+        if (entry.key.type != msgpack::type::STR || entry.val.type != msgpack::type::STR)
+        {
+            continue;
+        }
+
+        const auto key = entry.key.as<std::string>();
+        if (key == "type")
+        {
+            message.first = entry.val.as<std::string>();
+        } else if (key == "path")
+        {
+            message.second = entry.val.as<std::string>();
+        }
+    }
+    return message;
+}
+
+int main()
+{
+    // The messages are only passed to the sink, no server is started.
+    std::vector<Message> messages;
+    MeshcatCpp::MeshcatParams params;
+    params.transport = MeshcatCpp::MeshcatParams::Transport::Headless;
+    params.message_sink = [&messages](std::string_view msg) {
+        messages.push_back(unpack_message(msg));
+    };
+
+    {
+        MeshcatCpp::Meshcat meshcat(params);
+
+        std::array<double, 16> transform = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+        constexpr auto order = MeshcatCpp::MatrixStorageOrdering::ColumnMajor;
+        auto matrix_view = MeshcatCpp::make_matrix_view(transform.data(), 4, 4, order);
+
+        meshcat.set_object("box", MeshcatCpp::Box(0.5, 0.5, 0.5));
+        matrix_view(1, 3) = 1.75;
+        meshcat.set_transform("box", matrix_view);
+        meshcat.set_property("box", "visible", false);
+        meshcat.delete_object("box");
+
+        // The destructor waits until the websocket thread publishes all the messages.
+    }
+
+    const std::vector<Message> expected = {{"set_object", "/meshcat/box"},
+                                           {"set_transform", "/meshcat/box"},
+                                           {"set_property", "/meshcat/box"},
+                                           {"delete", "/meshcat/box"}};
+
+    if (messages != expected)
+    {
+        std::cerr << "Unexpected messages received by the sink:" << std::endl;
+        for (const auto& [type, path] : messages)
+        {
+            std::cerr << "  " << type << " " << path << std::endl;
+        }
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "The sink received the " << messages.size() << " expected messages." << std::endl;
+    return EXIT_SUCCESS;
+}
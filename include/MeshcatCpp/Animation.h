@@ -0,0 +1,80 @@
+/**
+ * @file Animation.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_ANIMATION_H
+#define MESHCAT_CPP_ANIMATION_H
+
+#include <MeshcatCpp/MatrixView.h>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MeshcatCpp
+{
+
+/**
+ * Animation collects the keyframes of the transforms of a set of paths. Once published with
+ * Meshcat::set_animation(), the whole animation is played by the browser without any further
+ * message.
+ */
+class Animation
+{
+public:
+    /**
+     * Clip contains the keyframes of a path. The keyframes are stored in contiguous arrays that
+     * are sent as they are.
+     */
+    struct Clip
+    {
+        /** Frame of each keyframe. */
+        std::vector<float> times;
+        /** Position of each keyframe, stored as x, y, z. */
+        std::vector<float> positions;
+        /** Orientation of each keyframe, stored as a quaternion x, y, z, w. */
+        std::vector<float> quaternions;
+    };
+
+    /**
+     * Constructor.
+     * @param fps number of frames per second.
+     */
+    explicit Animation(double fps = 30);
+
+    /**
+     * Set the transform of a path at a given frame.
+     * @param frame the frame. The frames of a path must be set in non-decreasing order, a
+     * keyframe set on the last frame of the path replaces the previous one.
+     * @param path the path of the node, as in Meshcat::set_transform().
+     * @param matrix the 4x4 homogeneous transform. Only the translation and the rotation are
+     * animated.
+     */
+    void set_transform(std::size_t frame,
+                       std::string_view path,
+                       const MatrixView<const double>& matrix);
+
+    [[nodiscard]] double fps() const;
+
+    [[nodiscard]] bool empty() const;
+
+    /**
+     * Get the keyframes of all the paths. The paths are absolute (e.g. "/meshcat/box"), hence the
+     * different forms of a path passed to set_transform() share the same clip.
+     */
+    [[nodiscard]] const std::map<std::string, Clip, std::less<>>& clips() const;
+
+private:
+    double fps_;
+    std::map<std::string, Clip, std::less<>> clips_;
+};
+
+} // namespace MeshcatCpp
+
+#endif // MESHCAT_CPP_ANIMATION_H
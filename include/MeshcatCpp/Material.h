@@ -27,7 +27,8 @@ public:
         MeshPhongMaterial,
         MeshLambertMaterial,
         MeshToonMaterial,
-        LineBasicMaterial
+        LineBasicMaterial,
+        PointsMaterial
     };
 
     int color{(229 << 16) + (229 << 8) + 229};
@@ -38,6 +39,7 @@ public:
     std::optional<double> linewidth;
     std::optional<bool> wireframe;
     std::optional<double> wireframeLineWidth;
+    std::optional<double> size;
     bool vertexColors{false};
     Type type{Type::MeshPhongMaterial};
 
@@ -45,12 +47,15 @@ public:
                                                          {Type::MeshPhongMaterial, "MeshPhongMaterial"},
                                                          {Type::MeshLambertMaterial, "MeshLambertMaterial"},
                                                          {Type::MeshToonMaterial, "MeshToonMaterial"},
-                                                         {Type::LineBasicMaterial, "LineBasicMaterial"}};
+                                                         {Type::LineBasicMaterial, "LineBasicMaterial"},
+                                                         {Type::PointsMaterial, "PointsMaterial"}};
 
 
     void set_color(uint8_t r, uint8_t g, uint8_t b, double a = 1.0);
 
     static Material get_default_material();
+
+    static Material get_default_points_material();
 };
 
 } // namespace MeshcatCpp
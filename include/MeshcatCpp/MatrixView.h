@@ -10,6 +10,7 @@
 
 #include <cassert>
 
+#include <cstddef>
 #include <cstring>
 #include <type_traits>
 
@@ -271,6 +272,159 @@ public:
     }
 };
 
+/**
+ * FixedMatrixView implements a view interface of dense matrices whose size and storage ordering
+ * are known at compile time, e.g. the 4x4 homogeneous transforms. Since the strides are constant,
+ * the element access does not depend on runtime values and the copies between views are loops with
+ * a fixed number of iterations that the compiler can unroll and vectorize. A copy between views
+ * having the same ordering is a memcpy, otherwise it is a transposed copy.
+ * @note Copying or assigning a view only copies the pointer to the data. The elements are copied
+ * by copy_from().
+ */
+template <class ElementType,
+          std::ptrdiff_t Rows,
+          std::ptrdiff_t Cols,
+          MatrixStorageOrdering Order = MatrixStorageOrdering::RowMajor>
+class FixedMatrixView
+{
+public:
+    using element_type = ElementType;
+    using value_type = std::remove_cv_t<ElementType>;
+    using index_type = std::ptrdiff_t;
+    using pointer = element_type*;
+    using reference = element_type&;
+
+    // Used by MatrixView to detect the storage ordering, as for the Eigen matrices.
+    static constexpr bool IsRowMajor = Order == MatrixStorageOrdering::RowMajor;
+
+private:
+    pointer m_storage;
+
+    static constexpr index_type rawIndex(index_type row, index_type col)
+    {
+        if constexpr (Order == MatrixStorageOrdering::RowMajor)
+        {
+            return col + Cols * row;
+        } else
+        {
+            return Rows * col + row;
+        }
+    }
+
+public:
+    constexpr explicit FixedMatrixView(pointer in_data) noexcept
+        : m_storage(in_data)
+    {
+    }
+
+    constexpr FixedMatrixView(const FixedMatrixView& other) noexcept = default;
+
+    template <class OtherElementType,
+              class = std::enable_if_t<
+                  details::is_allowed_element_type_conversion<OtherElementType,
+                                                              element_type>::value>>
+    constexpr FixedMatrixView(const FixedMatrixView<OtherElementType, Rows, Cols, Order>& other)
+        : m_storage(other.data())
+    {
+    }
+
+    constexpr FixedMatrixView& operator=(const FixedMatrixView& other) noexcept = default;
+
+    /**
+     * Copy the elements of a view having the same size in the elements of this view.
+     */
+    template <class OtherElementType, MatrixStorageOrdering OtherOrder>
+    void copy_from(const FixedMatrixView<OtherElementType, Rows, Cols, OtherOrder>& other) const
+    {
+        using other_value_type = std::remove_cv_t<OtherElementType>;
+        if constexpr (OtherOrder == Order && std::is_same_v<other_value_type, value_type>)
+        {
+            std::memcpy(this->m_storage, other.data(), Rows * Cols * sizeof(value_type));
+        } else if constexpr (OtherOrder == Order)
+        {
+            for (index_type i = 0; i < Rows * Cols; i++)
+            {
+                this->m_storage[i] = static_cast<value_type>(other.data()[i]);
+            }
+        } else
+        {
+            for (index_type i = 0; i < Rows; i++)
+            {
+                for (index_type j = 0; j < Cols; j++)
+                {
+                    this->operator()(i, j) = static_cast<value_type>(other(i, j));
+                }
+            }
+        }
+    }
+
+    /**
+     * Copy the elements of a MatrixView having the same size. The storage ordering of the
+     * MatrixView is checked once, then the elements are copied as from a FixedMatrixView.
+     */
+    template <class OtherElementType>
+    void copy_from(const MatrixView<OtherElementType>& other) const
+    {
+        assert(other.rows() == Rows);
+        assert(other.cols() == Cols);
+
+        using RowMajorView
+            = FixedMatrixView<OtherElementType, Rows, Cols, MatrixStorageOrdering::RowMajor>;
+        using ColumnMajorView
+            = FixedMatrixView<OtherElementType, Rows, Cols, MatrixStorageOrdering::ColumnMajor>;
+        if (other.storageOrder() == MatrixStorageOrdering::RowMajor)
+        {
+            this->copy_from(RowMajorView(other.data()));
+        } else
+        {
+            this->copy_from(ColumnMajorView(other.data()));
+        }
+    }
+
+    static constexpr MatrixStorageOrdering storageOrder() noexcept
+    {
+        return Order;
+    }
+
+    pointer data() const noexcept
+    {
+        return m_storage;
+    }
+
+    /**
+     * @name Matrix interface methods.
+     * Methods exposing a matrix-like interface to FixedMatrixView.
+     *
+     */
+    ///@{
+    reference operator()(index_type row, const index_type col) const
+    {
+        assert(row < Rows);
+        assert(col < Cols);
+        return this->m_storage[rawIndex(row, col)];
+    }
+
+    static constexpr index_type rows() noexcept
+    {
+        return Rows;
+    }
+
+    static constexpr index_type cols() noexcept
+    {
+        return Cols;
+    }
+    ///@}
+};
+
+template <std::ptrdiff_t Rows,
+          std::ptrdiff_t Cols,
+          MatrixStorageOrdering Order = MatrixStorageOrdering::RowMajor,
+          class ElementType>
+constexpr FixedMatrixView<ElementType, Rows, Cols, Order> make_fixed_matrix_view(ElementType* ptr)
+{
+    return FixedMatrixView<ElementType, Rows, Cols, Order>(ptr);
+}
+
 template <class ElementType>
 constexpr MatrixView<ElementType>
 make_matrix_view(ElementType* ptr,
@@ -42,10 +42,18 @@
 #ifndef MESHCAT_CPP_MESHCAT_H
 #define MESHCAT_CPP_MESHCAT_H
 
+#include <array>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
+#include <MeshcatCpp/Animation.h>
 #include <MeshcatCpp/Material.h>
 #include <MeshcatCpp/MatrixView.h>
+#include <MeshcatCpp/MeshcatParams.h>
+#include <MeshcatCpp/Model.h>
+#include <MeshcatCpp/NodeHandle.h>
 #include <MeshcatCpp/Shape.h>
 
 namespace MeshcatCpp
@@ -61,6 +69,9 @@ namespace MeshcatCpp
  * viz.set_object("box", MeshcatCpp::Box(0.1, 0.1, 0.1));
  * @endverbatim
  * will start an interface between meshcat and load a box.
+ * @note The methods only enqueue the updates, which are executed by the websocket thread. They may
+ * also be called from that thread (e.g. from MeshcatParams::message_sink); in that case they never
+ * wait for the queue, and the updates are executed after the current callback returns.
  * @note the Design of this class took inspiration form drake Meshcat C++ implementation.
  * Please refer to https://github.com/RobotLocomotion/drake/issues/13038 if you are interested in
  * the original project.
@@ -77,6 +88,13 @@ public:
      */
     Meshcat();
 
+    /**
+     * Constructs the Meshcat instance. It will listen on the first available port starting at 7001
+     * (up to 7099).
+     * @param params the parameters used to configure the instance.
+     */
+    explicit Meshcat(const MeshcatParams& params);
+
     ~Meshcat();
 
     /**
@@ -85,8 +103,22 @@ public:
      */
     void join();
 
+    /**
+     * Get a handle to the node associated to a given path. The handle can be used to update the
+     * node without parsing the path and walking the scene tree at every call.
+     * @param path the path of the node.
+     * @return the handle to the node.
+     * @note The functions taking a path use the same handles, which are cached by path. Once a
+     * path has been used, setting its transform does not allocate memory, either by path or by
+     * handle. The other commands, e.g. set_property() and delete_object(), still allocate their
+     * message and the task that publishes it.
+     */
+    NodeHandle node(std::string_view path);
+
     void set_property(std::string_view path, const std::string& property, bool value);
 
+    void set_property(const NodeHandle& node, const std::string& property, bool value);
+
     void set_object(std::string_view path,
                     const Sphere& sphere,
                     const Material& material = Material::get_default_material());
@@ -107,9 +139,180 @@ public:
                     const Mesh& mesh,
                     const Material& material = Material::get_default_material());
 
+    /**
+     * Set a point cloud. The buffers of the cloud are serialized before the function returns.
+     * @param path the path of the object.
+     * @param cloud the point cloud.
+     * @param material the material. Its vertexColors flag is ignored if the cloud has no colors.
+     */
+    void set_object(std::string_view path,
+                    const PointCloud& cloud,
+                    const Material& material = Material::get_default_points_material());
+
+    /**
+     * Set a mesh built from memory buffers. The buffers are serialized before the function
+     * returns.
+     * @param path the path of the object.
+     * @param mesh the triangle mesh.
+     * @param material the material.
+     */
+    void set_object(std::string_view path,
+                    const TriangleMesh& mesh,
+                    const Material& material = Material::get_default_material());
+
+    /**
+     * Replace the point cloud associated to a path. Differently from set_object(), if the
+     * websocket thread or a client falls behind only the latest cloud of each path is sent.
+     * Hence, this function can be used to stream the data of a sensor.
+     * @param path the path of the object.
+     * @param cloud the point cloud.
+     * @param material the material. Its vertexColors flag is ignored if the cloud has no colors.
+     */
+    void update_point_cloud(std::string_view path,
+                            const PointCloud& cloud,
+                            const Material& material = Material::get_default_points_material());
+
+    /**
+     * Publish an animation. The animation is played by the browser, hence no message is sent
+     * while it is played. The animation replaces the one previously published.
+     * @param animation the animation.
+     * @param play if true the animation starts as soon as it is received.
+     * @param repetitions number of times the animation is played.
+     */
+    void set_animation(const Animation& animation, bool play = true, unsigned int repetitions = 1);
+
+    /**
+     * Publish an articulated model. Each link is a node nested in the node of its parent, i.e.
+     * path/root_link/child_link, and its visual shapes are the nodes visual_0, visual_1, ... of
+     * the link. The joints are set to zero.
+     * @param path the path of the model.
+     * @param model the model.
+     * @return the handle used to update the joint positions.
+     */
+    ModelHandle set_model(std::string_view path, const Model& model);
+
+    /**
+     * Update the joint positions of a model. The transforms of the links are computed and
+     * published as a single batch. Only the links whose joint position changed since the previous
+     * call are published.
+     * @param model the handle returned by set_model().
+     * @param positions (number of joints) x 1 matrix containing the positions of the movable
+     * joints, in the order in which their links are added to the model.
+     * @note std::runtime_error is thrown if the size of positions does not match the number of
+     * joints of the model.
+     */
+    void set_joint_positions(const ModelHandle& model, const MatrixView<const double>& positions);
+
+    /**
+     * Play a recording created by setting MeshcatParams::recording_path. The scene is cleared
+     * and the recorded messages are sent to the clients with their original timing, scaled by
+     * speed.
+     * @param recording the path of the recording.
+     * @param speed the playback speed, e.g. 2 plays the recording twice as fast.
+     * @note The scene should not be modified while a recording is played.
+     */
+    void replay(const std::string& recording, double speed = 1.0);
+
+    /**
+     * Move the playback of the recording to a given time. The scene at that time is sent again
+     * to the clients and the playback continues from there.
+     * @param time the time in seconds since the beginning of the recording.
+     */
+    void seek(double time);
+
+    /**
+     * Export the current scene to a self-contained html page that can be opened without running
+     * Meshcat, e.g. to attach the scene to a report. The function returns once the file is
+     * written.
+     * @param path the path of the html file.
+     * @note If it is called from the websocket thread (e.g. from MeshcatParams::message_sink) the
+     * page is written immediately and the conflated updates that are not published yet are not
+     * part of it.
+     * @note std::runtime_error is thrown if the file cannot be written.
+     */
+    void export_static_html(const std::string& path);
+
+    /**
+     * Delete a node and all its descendants. The objects, the transforms and the properties of
+     * the deleted nodes are removed from the scene sent to the new clients.
+     * @param path the path of the node.
+     */
+    void delete_object(std::string_view path);
+
+    void delete_object(const NodeHandle& node);
+
     void set_transform(std::string_view path, const MatrixView<const double>& matrix);
 
+    void set_transform(const NodeHandle& node, const MatrixView<const double>& matrix);
+
+    void set_transform(std::string_view path, const MatrixView<const float>& matrix);
+
+    void set_transform(const NodeHandle& node, const MatrixView<const float>& matrix);
+
+    /**
+     * Set the transform of a node from its position and orientation.
+     * @param path the path of the node.
+     * @param position the position (x, y, z).
+     * @param quaternion the orientation as a quaternion (x, y, z, w). It is normalized, hence it
+     * must be different from zero.
+     */
+    void set_transform(std::string_view path,
+                       const std::array<double, 3>& position,
+                       const std::array<double, 4>& quaternion);
+
+    void set_transform(const NodeHandle& node,
+                       const std::array<double, 3>& position,
+                       const std::array<double, 4>& quaternion);
+
+    /**
+     * Set the transforms of several nodes at once. Each transform is pushed to the command queue
+     * as a set_transform() call does, without packing it. The websocket thread packs and publishes
+     * the consecutive transforms in a single pass, and if the updates are conflated only the
+     * latest transform of each node is published.
+     * @param paths the paths of the nodes.
+     * @param matrices the 4x4 homogeneous transforms. matrices[i] is associated to paths[i].
+     * @note paths and matrices must have the same size.
+     */
+    void set_transforms(const std::vector<std::string>& paths,
+                        const std::vector<MatrixView<const double>>& matrices);
+
+    /**
+     * Set the transforms of several nodes at once.
+     * @param paths the paths of the nodes.
+     * @param matrices a 4 x (4 * paths.size()) matrix obtained by stacking horizontally the 4x4
+     * homogeneous transforms. The i-th block is associated to paths[i].
+     */
+    void set_transforms(const std::vector<std::string>& paths,
+                        const MatrixView<const double>& matrices);
+
+    void set_transforms(const std::vector<NodeHandle>& nodes,
+                        const std::vector<MatrixView<const double>>& matrices);
+
+    void set_transforms(const std::vector<NodeHandle>& nodes,
+                        const MatrixView<const double>& matrices);
+
+    /**
+     * Set the transforms of several nodes from their positions and orientations. The rotation
+     * matrices are computed by a vectorized kernel.
+     * @param paths the paths of the nodes.
+     * @param positions a 3 x paths.size() matrix. The i-th column is the position (x, y, z) of
+     * paths[i].
+     * @param quaternions a 4 x paths.size() matrix. The i-th column is the quaternion (x, y, z, w)
+     * of paths[i]. The quaternions are normalized, hence they must be different from zero.
+     * @note If the matrices are stored by row, i.e. each coordinate of the poses is a contiguous
+     * array (structure of arrays), the quaternions are copied to the kernel without reordering.
+     */
+    void set_transforms(const std::vector<std::string>& paths,
+                        const MatrixView<const double>& positions,
+                        const MatrixView<const double>& quaternions);
+
+    void set_transforms(const std::vector<NodeHandle>& nodes,
+                        const MatrixView<const double>& positions,
+                        const MatrixView<const double>& quaternions);
+
 private:
+    static const std::shared_ptr<details::NodeHandleData>& handle_data(const NodeHandle& node);
+
     class Impl;
     std::unique_ptr<Impl> pimpl_;
 };
@@ -0,0 +1,106 @@
+/**
+ * @file MeshcatParams.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_MESHCAT_PARAMS_H
+#define MESHCAT_CPP_MESHCAT_PARAMS_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace MeshcatCpp
+{
+
+/**
+ * MeshcatParams contains the parameters used to configure a Meshcat instance.
+ */
+struct MeshcatParams
+{
+    /**
+     * Transport used to publish the messages.
+     */
+    enum class Transport
+    {
+        /** The messages are sent to the browsers connected to a websocket server. */
+        WebSocket,
+        /**
+         * No server is started and the messages are only passed to message_sink. It can be used to
+         * test the code building a scene or to measure the overhead of the library without any
+         * networking.
+         */
+        Headless,
+    };
+
+    Transport transport{Transport::WebSocket};
+
+    /**
+     * Function called with each published message, as it is sent to the clients. It is called
+     * from the thread publishing the messages, hence it should return quickly. The message is
+     * valid only during the call. The messages are passed to the sink with both transports.
+     */
+    std::function<void(std::string_view)> message_sink;
+
+    /**
+     * If true the transforms and the properties that are not published yet are conflated, i.e.
+     * only the latest value set for each path (and property) is published. This bounds the memory
+     * and the latency required to catch up when the websocket thread falls behind.
+     */
+    bool conflate_updates{false};
+
+    /**
+     * Number of bytes buffered by a websocket above which the client is considered slow. The
+     * transforms and the properties sent to a slow client are kept aside, replacing the older
+     * messages associated to the same path (and property), and they are sent when the socket
+     * drains. The set_object messages are never dropped. Set it to zero to disable the policy.
+     */
+    std::size_t max_socket_backpressure{1024 * 1024};
+
+    /**
+     * Number of commands that can be queued before being processed by the websocket thread. The
+     * capacity is rounded up to a power of two. If the queue is full, the caller waits until the
+     * websocket thread processes some commands.
+     */
+    std::size_t command_queue_capacity{4096};
+
+    /**
+     * Maximum rate (in Hz) at which the transforms and the properties are published. If it is
+     * positive, the updates set within a frame are conflated (only the latest value of each path
+     * and property is kept) and they are published by a timer at the end of the frame. The
+     * set_object commands are not rate limited. Set it to zero to publish the updates as soon as
+     * possible.
+     */
+    double max_publish_rate{0};
+
+    /**
+     * If true the transforms are sent as a single Float32Array instead of an array of sixteen
+     * float64 values. This halves the size of the matrix in the message at the cost of the
+     * precision.
+     */
+    bool float32_transforms{false};
+
+    /**
+     * Maximum number of bytes of the scene sent to a new client at once. The scene is sent in
+     * slices, a new slice is sent once the socket drains, so a client that joins a large scene does
+     * not delay the updates sent to the other clients. Set it to zero to send the whole scene at
+     * once.
+     */
+    std::size_t snapshot_slice_size{256 * 1024};
+
+    /**
+     * Path of the file where the published messages are recorded. The messages are appended as
+     * they are sent, together with their time, and the recording can be played with
+     * Meshcat::replay(). The replayed messages are not recorded again. If a message cannot be
+     * written the error is reported and the recording is stopped. Leave it empty to disable the
+     * recording.
+     */
+    std::string recording_path;
+};
+
+} // namespace MeshcatCpp
+
+#endif // MESHCAT_CPP_MESHCAT_PARAMS_H
@@ -0,0 +1,171 @@
+/**
+ * @file Model.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_MODEL_H
+#define MESHCAT_CPP_MODEL_H
+
+#include <MeshcatCpp/Material.h>
+#include <MeshcatCpp/MatrixView.h>
+#include <MeshcatCpp/Shape.h>
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace MeshcatCpp
+{
+
+/**
+ * Model describes an articulated body as a tree of links connected by joints, as in a URDF. Each
+ * link may have some visual shapes attached with a fixed offset. Once published with
+ * Meshcat::set_model(), the pose of all the links is updated with a single call to
+ * Meshcat::set_joint_positions().
+ * @note The transforms are 4x4 homogeneous transforms stored by column.
+ */
+class Model
+{
+public:
+    enum class JointType
+    {
+        /** The link is rigidly attached to its parent. */
+        Fixed,
+        /** The link rotates about the axis of the joint, the position is an angle in radians. */
+        Revolute,
+        /** The link translates along the axis of the joint. */
+        Prismatic,
+    };
+
+    using Geometry = std::variant<Box, Cylinder, Ellipsoid, Mesh, Sphere>;
+
+    struct Visual
+    {
+        Geometry geometry;
+        /** Transform from the link to the shape. */
+        std::array<double, 16> origin;
+        Material material;
+    };
+
+    struct Link
+    {
+        std::string name;
+        /** Index of the parent link. It is equal to npos for the root link. */
+        std::size_t parent;
+        JointType joint_type;
+        /** Transform from the parent link to the link when the joint position is zero. */
+        std::array<double, 16> joint_origin;
+        /** Unit axis of the joint, expressed in the link frame. */
+        std::array<double, 3> joint_axis;
+        /** Index of the joint in the joint positions. It is equal to npos for fixed joints. */
+        std::size_t joint_index;
+        std::vector<Visual> visuals;
+    };
+
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * Constructor.
+     * @param root_link the name of the root link.
+     * @note std::runtime_error is thrown if the name is empty or if it contains '/'.
+     */
+    explicit Model(std::string_view root_link);
+
+    /**
+     * Add a link connected to a link already in the model.
+     * @param name the name of the link. It must be unique.
+     * @param parent the name of the parent link.
+     * @param type the type of the joint connecting the link to its parent.
+     * @param origin the transform from the parent link to the link when the joint position is
+     * zero.
+     * @param axis the axis of the joint, expressed in the link frame. It is normalized and it is
+     * ignored for the fixed joints.
+     * @note The movable joints are numbered in the order in which their links are added.
+     * @note std::runtime_error is thrown if the name is empty, if it contains '/' or if it is
+     * already used, if the parent does not exist or if the axis of a movable joint is zero.
+     */
+    void add_link(std::string_view name,
+                  std::string_view parent,
+                  JointType type,
+                  const MatrixView<const double>& origin,
+                  const std::array<double, 3>& axis = {0, 0, 1});
+
+    /**
+     * Attach a shape to a link.
+     * @param link the name of the link.
+     * @param geometry the shape.
+     * @param origin the transform from the link to the shape.
+     * @param material the material of the shape.
+     * @note std::runtime_error is thrown if the link does not exist.
+     */
+    void add_visual(std::string_view link,
+                    const Geometry& geometry,
+                    const MatrixView<const double>& origin,
+                    const Material& material = Material::get_default_material());
+
+    /**
+     * Compute the transform from the parent link to a link.
+     * @param link the index of the link.
+     * @param position the position of its joint. It is ignored for the fixed joints.
+     * @param transform the transform.
+     */
+    void link_transform(std::size_t link,
+                        double position,
+                        std::array<double, 16>& transform) const;
+
+    /**
+     * Get the number of movable joints, i.e. the number of joint positions.
+     */
+    [[nodiscard]] std::size_t number_of_joints() const;
+
+    /**
+     * Get the links. A link always follows its parent.
+     */
+    [[nodiscard]] const std::vector<Link>& links() const;
+
+private:
+    std::size_t find_link(std::string_view name) const;
+
+    std::vector<Link> links_;
+    std::size_t number_of_joints_{0};
+};
+
+namespace details
+{
+struct ModelData;
+} // namespace details
+
+/**
+ * ModelHandle is a reference to a model published by Meshcat::set_model(). It stores the nodes of
+ * the links and the last joint positions that have been published.
+ * @note Copying a ModelHandle is cheap, all the copies refer to the same model.
+ */
+class ModelHandle
+{
+public:
+    ModelHandle() = default;
+
+    /**
+     * Check if the handle refers to a model.
+     * @return True if the handle is valid, false otherwise.
+     */
+    [[nodiscard]] bool is_valid() const;
+
+private:
+    friend class Meshcat;
+
+    explicit ModelHandle(std::shared_ptr<details::ModelData> data);
+
+    std::shared_ptr<details::ModelData> data_;
+};
+
+} // namespace MeshcatCpp
+
+#endif // MESHCAT_CPP_MODEL_H
@@ -0,0 +1,59 @@
+/**
+ * @file NodeHandle.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_NODE_HANDLE_H
+#define MESHCAT_CPP_NODE_HANDLE_H
+
+#include <memory>
+#include <string>
+
+namespace MeshcatCpp
+{
+
+namespace details
+{
+struct NodeHandleData;
+} // namespace details
+
+/**
+ * NodeHandle is a lightweight reference to a node of the Meshcat scene tree. It stores the
+ * normalized path of the node and its msgpack representation. Moreover, once the handle is used
+ * for the first time, the node of the tree is cached. Hence, updating a node through its handle
+ * does not require to parse the path and to walk the tree.
+ * A NodeHandle can be obtained by calling Meshcat::node() and it must be used only with the
+ * Meshcat instance that created it.
+ * @note Copying a NodeHandle is cheap, all the copies refer to the same node.
+ */
+class NodeHandle
+{
+public:
+    NodeHandle() = default;
+
+    /**
+     * Check if the handle refers to a node.
+     * @return True if the handle is valid, false otherwise.
+     */
+    [[nodiscard]] bool is_valid() const;
+
+    /**
+     * Get the absolute path of the node.
+     * @return The absolute path of the node. An empty string is returned if the handle is not
+     * valid.
+     */
+    [[nodiscard]] const std::string& path() const;
+
+private:
+    friend class Meshcat;
+
+    explicit NodeHandle(std::shared_ptr<details::NodeHandleData> data);
+
+    std::shared_ptr<details::NodeHandleData> data_;
+};
+
+} // namespace MeshcatCpp
+
+#endif // MESHCAT_CPP_NODE_HANDLE_H
@@ -8,7 +8,12 @@
 #ifndef MESHCAT_CPP_SHAPE_H
 #define MESHCAT_CPP_SHAPE_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+
+#include <MeshcatCpp/MatrixView.h>
 
 #define MESHCAT_CPP_ADD_SHAPE_ATTRIBUTE(type, attribute) \
 private:                                                 \
@@ -73,6 +78,73 @@ public:
     MESHCAT_CPP_ADD_SHAPE_ATTRIBUTE(double, scale);
 };
 
+/**
+ * PointCloud represents a set of points with optional per-point colors. The class does not copy
+ * the buffers, it only stores a view of them. The buffers are serialized directly from the
+ * caller's memory when the point cloud is passed to Meshcat, hence they must be valid until
+ * Meshcat::set_object() or Meshcat::update_point_cloud() returns.
+ */
+class PointCloud : public Shape
+{
+public:
+    /**
+     * Constructor.
+     * @param positions the coordinates of the points. It must be either a 3xN column major matrix
+     * or a Nx3 row major matrix, i.e. the coordinates of each point must be contiguous in memory.
+     * @param colors the RGB colors of the points. It must have the same layout of positions. If
+     * it is empty, the points are drawn with the color of the material.
+     */
+    PointCloud(const MatrixView<const float>& positions,
+               const MatrixView<const uint8_t>& colors = MatrixView<const uint8_t>());
+
+    /**
+     * Get the number of points.
+     * @return the number of points of the cloud.
+     */
+    [[nodiscard]] std::size_t number_of_points() const;
+
+    /**
+     * Check if the cloud has per-point colors.
+     * @return True if the colors are available.
+     */
+    [[nodiscard]] bool has_colors() const;
+
+    MESHCAT_CPP_ADD_SHAPE_ATTRIBUTE(MatrixView<const float>, positions);
+    MESHCAT_CPP_ADD_SHAPE_ATTRIBUTE(MatrixView<const uint8_t>, colors);
+};
+
+/**
+ * TriangleMesh represents a mesh built from vertex, normal and index buffers. As for PointCloud,
+ * the class only stores a view of the buffers, that are serialized directly from the caller's
+ * memory when the mesh is passed to Meshcat::set_object().
+ */
+class TriangleMesh : public Shape
+{
+public:
+    /**
+     * Constructor.
+     * @param vertices the coordinates of the vertices. It must be either a 3xN column major
+     * matrix or a Nx3 row major matrix.
+     * @param faces the indices of the vertices of each triangle. It must be either a 3xM column
+     * major matrix or a Mx3 row major matrix.
+     * @param normals the normals of the vertices. It must have the same layout of vertices. If it
+     * is empty, the normals are not sent and the lit materials will not shade the mesh.
+     */
+    TriangleMesh(const MatrixView<const float>& vertices,
+                 const MatrixView<const uint32_t>& faces,
+                 const MatrixView<const float>& normals = MatrixView<const float>());
+
+    [[nodiscard]] std::size_t number_of_vertices() const;
+
+    [[nodiscard]] std::size_t number_of_faces() const;
+
+    [[nodiscard]] bool has_normals() const;
+
+    MESHCAT_CPP_ADD_SHAPE_ATTRIBUTE(MatrixView<const float>, vertices);
+    MESHCAT_CPP_ADD_SHAPE_ATTRIBUTE(MatrixView<const uint32_t>, faces);
+    MESHCAT_CPP_ADD_SHAPE_ATTRIBUTE(MatrixView<const float>, normals);
+};
+
 
 } // namespace MeshcatCpp
 
@@ -0,0 +1,135 @@
+/**
+ * @file CommandQueue.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_COMMAND_QUEUE_H
+#define MESHCAT_CPP_COMMAND_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace MeshcatCpp::details
+{
+
+/**
+ * CommandQueue is a fixed-capacity lock-free queue that can be used by multiple producers and a
+ * single consumer. The elements are stored in a ring of pre-allocated cells, hence pushing and
+ * popping an element do not allocate memory.
+ * @note The implementation follows the bounded queue proposed by Dmitry Vyukov
+ * https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ */
+template <class T> class CommandQueue
+{
+public:
+    /**
+     * Constructor.
+     * @param capacity the minimum number of elements that can be stored in the queue. The actual
+     * capacity is the smallest power of two greater than or equal to capacity.
+     */
+    explicit CommandQueue(std::size_t capacity)
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+        {
+            size *= 2;
+        }
+
+        mask_ = size - 1;
+        cells_ = std::make_unique<Cell[]>(size);
+        for (std::size_t i = 0; i < size; i++)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    /**
+     * Push an element in the queue. It can be called by any thread.
+     * @param value the element. It is moved only if the element is pushed.
+     * @return True if the element is pushed, false if the queue is full.
+     */
+    bool push(T& value)
+    {
+        std::size_t position = enqueue_position_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = cells_[position & mask_];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference
+                = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (difference == 0)
+            {
+                if (enqueue_position_.compare_exchange_weak(position,
+                                                            position + 1,
+                                                            std::memory_order_relaxed))
+                {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0)
+            {
+                return false;
+            } else
+            {
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Pop an element from the queue. It must be called only by the consumer thread.
+     * @param value the popped element.
+     * @return True if an element is popped, false if the queue is empty.
+     */
+    bool pop(T& value)
+    {
+        const std::size_t position = dequeue_position_;
+        Cell& cell = cells_[position & mask_];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1) < 0)
+        {
+            return false;
+        }
+
+        value = std::move(cell.value);
+        cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+        dequeue_position_ = position + 1;
+        return true;
+    }
+
+    /**
+     * Get the capacity of the queue.
+     * @return the maximum number of elements that can be stored in the queue.
+     */
+    [[nodiscard]] std::size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_{0};
+
+    // The producer and the consumer positions are stored in different cache lines to avoid false
+    // sharing.
+    alignas(64) std::atomic<std::size_t> enqueue_position_{0};
+    alignas(64) std::size_t dequeue_position_{0};
+};
+
+} // namespace MeshcatCpp::details
+
+#endif // MESHCAT_CPP_COMMAND_QUEUE_H
@@ -0,0 +1,162 @@
+/**
+ * @file DefinitionCache.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_DEFINITION_CACHE_H
+#define MESHCAT_CPP_DEFINITION_CACHE_H
+
+#include <MeshcatCpp/impl/MsgpackTypes.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <msgpack.hpp>
+
+namespace MeshcatCpp::details
+{
+
+/**
+ * Compute the key used to intern a definition. Two definitions have the same key if they are
+ * equal once their uuid is ignored.
+ */
+template <typename T> std::string definition_key(const T& definition)
+{
+    T anonymous = definition;
+    anonymous.uuid.clear();
+
+    std::string key;
+    StringBuffer buffer{key};
+    msgpack::pack(buffer, anonymous);
+    return key;
+}
+
+/**
+ * The content of a mesh file is identified by its path, its size and its last write time, hence
+ * the file is not packed to compute the key.
+ */
+inline std::string definition_key(const MeshTrampoline& definition)
+{
+    const auto& file = definition.file;
+    return definition.mesh.type + '/' + definition.format + '/'
+           + std::to_string(file.last_write_time.time_since_epoch().count()) + '/'
+           + std::to_string(file.size) + '/' + definition.mesh.file_path();
+}
+
+/**
+ * DefinitionCache interns the definitions of the geometries (or of the materials). All the
+ * objects that have the same geometry share the same uuid and the same packed definition, hence
+ * the definition is packed and stored only once. A definition is kept alive as long as an object
+ * uses it. The cache can be used by any thread.
+ */
+class DefinitionCache
+{
+public:
+    /**
+     * Constructor.
+     * @param name the key of the definitions in the set_object message, i.e. "geometries" or
+     * "materials".
+     */
+    explicit DefinitionCache(std::string name)
+        : name_(std::move(name))
+    {
+    }
+
+    DefinitionCache(const DefinitionCache&) = delete;
+    DefinitionCache& operator=(const DefinitionCache&) = delete;
+
+    /**
+     * Get the shared definition equal to a given one. If it does not exist, the definition is
+     * packed and stored in the cache.
+     * @param definition the trampoline of the geometry (material).
+     * @return the shared definition.
+     */
+    template <typename T> std::shared_ptr<const Definition> intern(const T& definition)
+    {
+        std::string key = definition_key(definition);
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            auto it = this->definitions_.find(key);
+            if (it != this->definitions_.end())
+            {
+                if (auto shared = it->second.lock())
+                {
+                    return shared;
+                }
+            }
+        }
+
+        // The definition is packed without holding the lock since it may be large (e.g. a mesh).
+        std::shared_ptr<const Definition> shared = this->pack(definition);
+
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->remove_expired();
+        auto& entry = this->definitions_[std::move(key)];
+        if (auto existing = entry.lock())
+        {
+            // Another thread interned the same definition in the meantime.
+            return existing;
+        }
+        entry = shared;
+        return shared;
+    }
+
+    /**
+     * Pack a definition without interning it.
+     * @param definition the trampoline of the geometry (material).
+     * @param size_hint the number of bytes reserved for the packed definition.
+     * @return the packed definition.
+     */
+    template <typename T>
+    std::shared_ptr<const Definition> pack(const T& definition, std::size_t size_hint = 0) const
+    {
+        auto packed = std::make_shared<Definition>();
+        packed->uuid = definition.uuid;
+        packed->packed.reserve(size_hint);
+
+        StringBuffer buffer{packed->packed};
+        msgpack::packer<StringBuffer> o(buffer);
+        o.pack(this->name_);
+        o.pack_array(1);
+        o.pack(definition);
+        return packed;
+    }
+
+private:
+    /**
+     * Remove the definitions that are not used anymore. The cache is swept only when its size
+     * doubles, so the cost is amortized over the insertions.
+     */
+    void remove_expired()
+    {
+        if (this->definitions_.size() < this->sweep_size_)
+        {
+            return;
+        }
+
+        for (auto it = this->definitions_.begin(); it != this->definitions_.end();)
+        {
+            it = it->second.expired() ? this->definitions_.erase(it) : std::next(it);
+        }
+        this->sweep_size_ = std::max(min_sweep_size, 2 * this->definitions_.size());
+    }
+
+    static constexpr std::size_t min_sweep_size = 64;
+
+    const std::string name_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::weak_ptr<const Definition>> definitions_;
+    std::size_t sweep_size_{min_sweep_size};
+};
+
+} // namespace MeshcatCpp::details
+
+#endif // MESHCAT_CPP_DEFINITION_CACHE_H
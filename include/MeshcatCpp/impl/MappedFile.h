@@ -0,0 +1,79 @@
+/**
+ * @file MappedFile.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_MAPPED_FILE_H
+#define MESHCAT_CPP_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace MeshcatCpp::details
+{
+
+/**
+ * MappedFile is a file mapped in memory. A file opened for writing is created (or truncated) and
+ * the data can only be appended. The mapping grows geometrically, and the file is truncated to the
+ * written size when the object is destroyed.
+ */
+class MappedFile
+{
+public:
+    enum class Mode
+    {
+        Read,
+        Write
+    };
+
+    /**
+     * Constructor.
+     * @param path the path of the file.
+     * @param mode the access mode.
+     * @note std::runtime_error is thrown if the file cannot be opened or mapped.
+     */
+    MappedFile(const std::string& path, Mode mode);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Append data at the end of a file opened for writing.
+     * @param data pointer to the data.
+     * @param size number of bytes.
+     */
+    void append(const void* data, std::size_t size);
+
+    [[nodiscard]] const char* data() const;
+
+    /**
+     * Get the size of the file.
+     * @return the size of a file opened for reading, or the number of bytes written in a file
+     * opened for writing.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    void map(std::size_t capacity);
+    void unmap();
+
+    const Mode mode_;
+    char* data_{nullptr};
+    std::size_t size_{0};
+    std::size_t capacity_{0};
+
+#ifdef _WIN32
+    void* file_{nullptr};
+    void* mapping_{nullptr};
+#else
+    int fd_{-1};
+#endif
+};
+
+} // namespace MeshcatCpp::details
+
+#endif // MESHCAT_CPP_MAPPED_FILE_H
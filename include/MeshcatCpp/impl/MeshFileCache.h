@@ -0,0 +1,90 @@
+/**
+ * @file MeshFileCache.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_MESH_FILE_CACHE_H
+#define MESHCAT_CPP_MESH_FILE_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace MeshcatCpp::details
+{
+
+/**
+ * MeshFileCache is a process-wide cache of the content of the mesh files. A file is read only the
+ * first time it is requested, then all the meshes that refer to the same file share the same
+ * immutable buffer. An entry is identified by the path of the file, its size and its last write
+ * time, so a file modified on disk is read again.
+ * @note A buffer is kept alive as long as a mesh uses it.
+ */
+class MeshFileCache
+{
+public:
+    using Buffer = std::shared_ptr<const std::vector<char>>;
+
+    /**
+     * File read from the disk. The size and the last write time identify the version of the file.
+     */
+    struct File
+    {
+        Buffer data;
+        std::filesystem::file_time_type last_write_time{};
+        std::uintmax_t size{0};
+    };
+
+    /**
+     * Get the size and the last write time of a file without reading it. It can be called by any
+     * thread.
+     * @param path the path of the file.
+     * @return the file. Its data is set only if the content of the file is already in the cache.
+     */
+    File stat(const std::string& path);
+
+    /**
+     * Get the content of a file. It can be called by any thread.
+     * @param path the path of the file.
+     * @return the file. Its data is a null pointer if the file cannot be read.
+     */
+    File load(const std::string& path);
+
+    static MeshFileCache& cache();
+
+private:
+    MeshFileCache() = default;
+    ~MeshFileCache() = default;
+    MeshFileCache(const MeshFileCache&) = delete;
+    MeshFileCache& operator=(const MeshFileCache&) = delete;
+
+    /**
+     * Remove the entries whose buffer is not used anymore. The cache is swept only when its size
+     * doubles, so the cost is amortized over the insertions.
+     */
+    void remove_expired();
+
+    struct Entry
+    {
+        std::filesystem::file_time_type last_write_time;
+        std::uintmax_t size;
+        std::weak_ptr<const std::vector<char>> data;
+    };
+
+    static constexpr std::size_t min_sweep_size = 64;
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::size_t sweep_size_{min_sweep_size};
+};
+
+} // namespace MeshcatCpp::details
+
+#endif // MESHCAT_CPP_MESH_FILE_CACHE_H
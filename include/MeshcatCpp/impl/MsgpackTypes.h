@@ -8,11 +8,21 @@
 #ifndef MESHCAT_CPP_MSGPACK_TYPES_H
 #define MESHCAT_CPP_MSGPACK_TYPES_H
 
+#include <MeshcatCpp/Animation.h>
 #include <MeshcatCpp/Material.h>
 #include <MeshcatCpp/MatrixView.h>
 #include <MeshcatCpp/Shape.h>
+#include <MeshcatCpp/impl/MeshFileCache.h>
+#include <MeshcatCpp/impl/SharedMessage.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 #include <msgpack.hpp>
 
@@ -59,9 +69,81 @@ template <typename T> struct traits<const T> : traits<T>
 {
 };
 
+/**
+ * typed_array_ext_type contains the msgpack extension type used by meshcat to encode a JavaScript
+ * typed array of a given element type.
+ */
+template <typename T> struct typed_array_ext_type;
+
+template <> struct typed_array_ext_type<uint8_t>
+{
+    static constexpr int8_t value = 0x12;
+    static constexpr const char* name = "Uint8Array";
+};
+
+template <> struct typed_array_ext_type<uint32_t>
+{
+    static constexpr int8_t value = 0x16;
+    static constexpr const char* name = "Uint32Array";
+};
+
+template <> struct typed_array_ext_type<float>
+{
+    static constexpr int8_t value = 0x17;
+    static constexpr const char* name = "Float32Array";
+};
+
+/**
+ * Pack a buffer as a JavaScript typed array. The bytes are copied as they are, hence the buffer is
+ * decoded correctly by the client only if the host is little-endian.
+ * @param o the msgpack packer.
+ * @param data pointer to the first element of the buffer.
+ * @param size number of elements of the buffer.
+ */
+template <typename Packer, typename T>
+void pack_typed_array(Packer& o, const T* data, std::size_t size)
+{
+    const auto bytes = static_cast<uint32_t>(size * sizeof(T));
+    o.pack_ext(bytes, typed_array_ext_type<T>::value);
+    o.pack_ext_body(reinterpret_cast<const char*>(data), bytes);
+}
+
+/**
+ * Pack a buffer as a three.js BufferAttribute.
+ * @param o the msgpack packer.
+ * @param data pointer to the first element of the buffer.
+ * @param size number of elements of the buffer.
+ * @param itemSize number of elements associated to each vertex.
+ * @param normalized if true the integer values are normalized in [0, 1] by the client.
+ */
+template <typename Packer, typename T>
+void pack_buffer_attribute(
+    Packer& o, const T* data, std::size_t size, int itemSize, bool normalized = false)
+{
+    o.pack_map(4);
+    PACK_MAP_VAR(o, itemSize);
+    PACK_MAP_VAR_WITH_NAME(o, type, typed_array_ext_type<T>::name);
+    o.pack("array");
+    pack_typed_array(o, data, size);
+    PACK_MAP_VAR(o, normalized);
+}
+
+/**
+ * StringBuffer is a msgpack output stream that appends the packed data to a std::string.
+ */
+struct StringBuffer
+{
+    std::string& data;
+
+    void write(const char* buffer, std::size_t length)
+    {
+        this->data.append(buffer, length);
+    }
+};
+
 struct MaterialTrampoline
 {
-    const std::string uuid;
+    std::string uuid;
     const ::MeshcatCpp::Material material;
 
     MaterialTrampoline(const ::MeshcatCpp::Material& material);
@@ -83,6 +165,8 @@ struct MaterialTrampoline
             ++n;
         if (material.wireframeLineWidth)
             ++n;
+        if (material.size)
+            ++n;
 
         o.pack_map(n);
         PACK_MAP_VAR(o, uuid);
@@ -98,6 +182,7 @@ struct MaterialTrampoline
         PACK_MAP_OPTIONAL_VAR_FROM_INNER_CLASS(o, material, transparent);
         PACK_MAP_OPTIONAL_VAR_FROM_INNER_CLASS(o, material, wireframe);
         PACK_MAP_OPTIONAL_VAR_FROM_INNER_CLASS(o, material, wireframeLineWidth);
+        PACK_MAP_OPTIONAL_VAR_FROM_INNER_CLASS(o, material, size);
     }
 
     // This method must be defined, but the implementation is not needed.
@@ -126,14 +211,9 @@ struct ObjectMetaData
 
 struct GeometryData
 {
-    virtual ~GeometryData() = default;
-
     GeometryData();
 
-    const std::string uuid;
-
-    // NOLINTNEXTLINE(runtime/references) cpplint disapproves of msgpack choices.
-    virtual void msgpack_pack(msgpack::packer<std::stringstream>& o) const = 0;
+    std::string uuid;
 
     // This method must be defined, but the implementation is not needed in the
     // current workflows.
@@ -149,7 +229,15 @@ struct SphereTrampoline : public GeometryData
 
     SphereTrampoline(const ::MeshcatCpp::Sphere& sphere);
 
-    void msgpack_pack(msgpack::packer<std::stringstream>& o) const override;
+    template <typename Packer> void msgpack_pack(Packer& o) const
+    {
+        o.pack_map(5);
+        PACK_MAP_VAR_FROM_INNER_CLASS(o, sphere, type);
+        PACK_MAP_VAR(o, uuid);
+        PACK_MAP_VAR_WITH_NAME(o, radius, sphere.radius());
+        PACK_MAP_VAR(o, widthSegments);
+        PACK_MAP_VAR(o, heightSegments);
+    }
 };
 
 SHAPE_TRAMPOLINE(Ellipsoid);
@@ -161,7 +249,16 @@ struct EllipsoidTrampoline : public GeometryData
 
     EllipsoidTrampoline(const ::MeshcatCpp::Ellipsoid& ellipsoid);
 
-    void msgpack_pack(msgpack::packer<std::stringstream>& o) const override;
+    template <typename Packer> void msgpack_pack(Packer& o) const
+    {
+        constexpr int radius = 1;
+        o.pack_map(5);
+        PACK_MAP_VAR_FROM_INNER_CLASS(o, ellipsoid, type);
+        PACK_MAP_VAR(o, uuid);
+        PACK_MAP_VAR_WITH_NAME(o, radius, radius);
+        PACK_MAP_VAR(o, widthSegments);
+        PACK_MAP_VAR(o, heightSegments);
+    }
 };
 
 SHAPE_TRAMPOLINE(Box);
@@ -173,7 +270,15 @@ struct BoxTrampoline : public GeometryData
 
     BoxTrampoline(const ::MeshcatCpp::Box& sphere);
 
-    void msgpack_pack(msgpack::packer<std::stringstream>& o) const override;
+    template <typename Packer> void msgpack_pack(Packer& o) const
+    {
+        o.pack_map(5);
+        PACK_MAP_VAR_FROM_INNER_CLASS(o, box, type);
+        PACK_MAP_VAR(o, uuid);
+        PACK_MAP_VAR_WITH_NAME(o, width, box.width());
+        PACK_MAP_VAR_WITH_NAME(o, height, box.depth());
+        PACK_MAP_VAR_WITH_NAME(o, depth, box.height());
+    }
 };
 
 SHAPE_TRAMPOLINE(Cylinder);
@@ -185,7 +290,16 @@ struct CylinderTrampoline : public GeometryData
 
     CylinderTrampoline(const ::MeshcatCpp::Cylinder& cylinder);
 
-    void msgpack_pack(msgpack::packer<std::stringstream>& o) const override;
+    template <typename Packer> void msgpack_pack(Packer& o) const
+    {
+        o.pack_map(6);
+        PACK_MAP_VAR_FROM_INNER_CLASS(o, cylinder, type);
+        PACK_MAP_VAR(o, uuid);
+        PACK_MAP_VAR_WITH_NAME(o, radiusTop, cylinder.radius());
+        PACK_MAP_VAR_WITH_NAME(o, radiusBottom, cylinder.radius());
+        PACK_MAP_VAR_WITH_NAME(o, height, cylinder.height());
+        PACK_MAP_VAR(o, radialSegments);
+    }
 };
 
 SHAPE_TRAMPOLINE(Mesh);
@@ -194,11 +308,109 @@ struct MeshTrampoline : public GeometryData
     const ::MeshcatCpp::Mesh mesh;
 
     std::string format;
-    std::vector<char> data;
+
+    /**
+     * Version of the file. Its content is set only if it is already in the MeshFileCache, so that
+     * the file is not read when the definition is already interned.
+     */
+    MeshFileCache::File file;
 
     MeshTrampoline(const ::MeshcatCpp::Mesh& mesh);
 
-    void msgpack_pack(msgpack::packer<std::stringstream>& o) const override;
+    template <typename Packer> void msgpack_pack(Packer& o) const
+    {
+        // The content is shared by all the meshes referring to the same file.
+        const MeshFileCache::Buffer data = file.data != nullptr
+                                               ? file.data
+                                               : MeshFileCache::cache().load(mesh.file_path()).data;
+        const std::size_t size = data == nullptr ? 0 : data->size();
+
+        o.pack_map(4);
+        PACK_MAP_VAR_FROM_INNER_CLASS(o, mesh, type);
+        PACK_MAP_VAR(o, uuid);
+        PACK_MAP_VAR(o, format);
+        o.pack("data");
+        o.pack_bin(size);
+        if (size > 0)
+        {
+            o.pack_bin_body(data->data(), size);
+        }
+    }
+};
+
+SHAPE_TRAMPOLINE(PointCloud);
+struct PointCloudTrampoline : public GeometryData
+{
+    const ::MeshcatCpp::PointCloud cloud;
+
+    PointCloudTrampoline(const ::MeshcatCpp::PointCloud& cloud);
+
+    template <typename Packer> void msgpack_pack(Packer& o) const
+    {
+        // The buffers are packed directly from the memory of the caller.
+        constexpr int itemSize = 3;
+        const std::size_t size = itemSize * cloud.number_of_points();
+
+        o.pack_map(3);
+        PACK_MAP_VAR(o, uuid);
+        PACK_MAP_VAR_FROM_INNER_CLASS(o, cloud, type);
+        o.pack("data");
+        o.pack_map(1);
+        o.pack("attributes");
+        o.pack_map(cloud.has_colors() ? 2 : 1);
+        o.pack("position");
+        pack_buffer_attribute(o, cloud.positions().data(), size, itemSize);
+        if (cloud.has_colors())
+        {
+            constexpr bool normalized = true;
+            o.pack("color");
+            pack_buffer_attribute(o, cloud.colors().data(), size, itemSize, normalized);
+        }
+    }
+
+    /**
+     * Get the size of the buffers of the point cloud.
+     * @return the number of bytes required to store the buffers.
+     */
+    [[nodiscard]] std::size_t buffers_size() const;
+};
+
+SHAPE_TRAMPOLINE(TriangleMesh);
+struct TriangleMeshTrampoline : public GeometryData
+{
+    const ::MeshcatCpp::TriangleMesh mesh;
+
+    TriangleMeshTrampoline(const ::MeshcatCpp::TriangleMesh& mesh);
+
+    template <typename Packer> void msgpack_pack(Packer& o) const
+    {
+        // The buffers are packed directly from the memory of the caller.
+        constexpr int itemSize = 3;
+        const std::size_t vertices_size = itemSize * mesh.number_of_vertices();
+
+        o.pack_map(3);
+        PACK_MAP_VAR(o, uuid);
+        PACK_MAP_VAR_FROM_INNER_CLASS(o, mesh, type);
+        o.pack("data");
+        o.pack_map(2);
+        o.pack("attributes");
+        o.pack_map(mesh.has_normals() ? 2 : 1);
+        o.pack("position");
+        pack_buffer_attribute(o, mesh.vertices().data(), vertices_size, itemSize);
+        if (mesh.has_normals())
+        {
+            o.pack("normal");
+            pack_buffer_attribute(o, mesh.normals().data(), vertices_size, itemSize);
+        }
+        o.pack("index");
+        pack_buffer_attribute(o, mesh.faces().data(), itemSize * mesh.number_of_faces(), 1);
+    }
+
+    /**
+     * Get the size of the buffers of the mesh.
+     * @return the number of bytes required to store the buffers.
+     */
+    [[nodiscard]] std::size_t buffers_size() const;
 };
 
 struct MeshData
@@ -214,6 +426,14 @@ struct MeshData
 
     MeshcatCpp::MatrixView<double> matrix();
 
+    template <typename T> void update_type_from_shape(const T&)
+    {
+        if constexpr (std::is_same_v<T, ::MeshcatCpp::PointCloud>)
+        {
+            this->type = "Points";
+        }
+    }
+
     template <typename T> void update_matrix_from_shape(const T& shape)
     {
         if constexpr (std::is_same_v<T, ::MeshcatCpp::Ellipsoid>)
@@ -234,10 +454,12 @@ struct MeshData
     MSGPACK_DEFINE_MAP(uuid, type, geometry, material, MSGPACK_NVP("matrix", matrix_vec));
 };
 
-struct LumpedObjectData
+template <typename Geometry> struct LumpedObjectData
 {
+    static_assert(std::is_base_of_v<GeometryData, Geometry>, "Invalid geometry type");
+
     ObjectMetaData metadata;
-    std::unique_ptr<GeometryData> geometry;
+    std::unique_ptr<Geometry> geometry;
     std::unique_ptr<MaterialTrampoline> material;
     MeshData object;
 
@@ -280,14 +502,185 @@ struct LumpedObjectData
     }
 };
 
-struct SetObjectData
+template <typename Geometry> struct SetObjectData
 {
     std::string type{"set_object"};
     std::string path;
-    LumpedObjectData object;
+    LumpedObjectData<Geometry> object;
     MSGPACK_DEFINE_MAP(type, path, object);
 };
 
+/**
+ * SetAnimationData packs a set_animation message. The keyframes of each path are sent as typed
+ * arrays.
+ */
+struct SetAnimationData
+{
+    const ::MeshcatCpp::Animation& animation;
+    // The absolute paths of the clips of the animation, in the same order.
+    std::vector<std::string> paths;
+    bool play{true};
+    unsigned int repetitions{1};
+
+    template <typename Packer> void msgpack_pack(Packer& o) const
+    {
+        // THREE.LoopRepeat
+        constexpr int loopMode = 2201;
+        constexpr bool clampWhenFinished = true;
+        const double fps = animation.fps();
+
+        o.pack_map(4);
+        PACK_MAP_VAR_WITH_NAME(o, type, "set_animation");
+        o.pack("animations");
+        o.pack_array(animation.clips().size());
+        auto path = paths.begin();
+        for (const auto& [name, clip] : animation.clips())
+        {
+            o.pack_map(2);
+            PACK_MAP_VAR_WITH_NAME(o, path, *path++);
+            o.pack("clip");
+            o.pack_map(3);
+            PACK_MAP_VAR(o, fps);
+            PACK_MAP_VAR_WITH_NAME(o, name, "default");
+            o.pack("tracks");
+            o.pack_array(2);
+            pack_track(o, ".position", "vector3", clip.times, clip.positions);
+            pack_track(o, ".quaternion", "quaternion", clip.times, clip.quaternions);
+        }
+
+        o.pack("options");
+        o.pack_map(4);
+        PACK_MAP_VAR(o, play);
+        PACK_MAP_VAR(o, clampWhenFinished);
+        PACK_MAP_VAR(o, loopMode);
+        PACK_MAP_VAR(o, repetitions);
+        PACK_MAP_VAR_WITH_NAME(o, path, "");
+    }
+
+    /**
+     * Get the size of the keyframes of the animation.
+     * @return the number of bytes required to store the keyframes.
+     */
+    [[nodiscard]] std::size_t buffers_size() const
+    {
+        std::size_t size = 0;
+        for (const auto& [name, clip] : animation.clips())
+        {
+            size += (2 * clip.times.size() + clip.positions.size() + clip.quaternions.size())
+                    * sizeof(float);
+        }
+        return size;
+    }
+
+private:
+    template <typename Packer>
+    static void pack_track(Packer& o,
+                           const char* name,
+                           const char* type,
+                           const std::vector<float>& times,
+                           const std::vector<float>& values)
+    {
+        o.pack_map(4);
+        PACK_MAP_VAR(o, name);
+        PACK_MAP_VAR(o, type);
+        o.pack("times");
+        pack_typed_array(o, times.data(), times.size());
+        o.pack("values");
+        pack_typed_array(o, values.data(), values.size());
+    }
+};
+
+struct DeleteData
+{
+    std::string type{"delete"};
+    std::string path;
+    MSGPACK_DEFINE_MAP(type, path);
+};
+
+/**
+ * Definition is the packed definition of a geometry or of a material, i.e. the "geometries" or the
+ * "materials" entry of a set_object message. It is immutable, hence it can be shared by all the
+ * objects that use the same geometry (material).
+ */
+struct Definition
+{
+    std::string uuid;
+    std::string packed;
+};
+
+/**
+ * ObjectMessage is a packed set_object message whose geometry and material definitions may be
+ * shared with other messages. A segmented message is made of the head, the geometry, the material
+ * and the tail. If the message is not segmented, the head contains the whole message.
+ */
+struct ObjectMessage
+{
+    SharedMessage head;
+    std::shared_ptr<const Definition> geometry;
+    std::shared_ptr<const Definition> material;
+    std::string tail;
+
+    [[nodiscard]] bool is_segmented() const
+    {
+        return this->geometry != nullptr && this->material != nullptr;
+    }
+
+    /**
+     * Get a contiguous view of the message.
+     * @param buffer the buffer used to join the segments. It is cleared only if the message is
+     * segmented.
+     * @return a view of the message. The view is valid until the buffer or the message change.
+     */
+    std::string_view view(msgpack::sbuffer& buffer) const
+    {
+        if (!this->is_segmented())
+        {
+            return this->head.view();
+        }
+
+        buffer.clear();
+        buffer.write(this->head.view().data(), this->head.size());
+        buffer.write(this->geometry->packed.data(), this->geometry->packed.size());
+        buffer.write(this->material->packed.data(), this->material->packed.size());
+        buffer.write(this->tail.data(), this->tail.size());
+        return std::string_view(buffer.data(), buffer.size());
+    }
+};
+
+/**
+ * Pack a segmented set_object message.
+ * @param path the absolute path of the object.
+ * @param geometry the definition of the geometry.
+ * @param material the definition of the material.
+ * @param object the object. Its geometry and material uuids must match the definitions.
+ */
+inline ObjectMessage pack_object_message(const std::string& path,
+                                         std::shared_ptr<const Definition> geometry,
+                                         std::shared_ptr<const Definition> material,
+                                         const MeshData& object)
+{
+    ObjectMessage message;
+    message.geometry = std::move(geometry);
+    message.material = std::move(material);
+
+    std::string head_message;
+    StringBuffer head{head_message};
+    msgpack::packer<StringBuffer> head_packer(head);
+    head_packer.pack_map(3);
+    PACK_MAP_VAR_WITH_NAME(head_packer, type, "set_object");
+    PACK_MAP_VAR(head_packer, path);
+    head_packer.pack("object");
+    head_packer.pack_map(4);
+    PACK_MAP_VAR_WITH_NAME(head_packer, metadata, ObjectMetaData{});
+    message.head = SharedMessage(std::move(head_message));
+
+    StringBuffer tail{message.tail};
+    msgpack::packer<StringBuffer> tail_packer(tail);
+    PACK_MAP_VAR(tail_packer, object);
+
+    return message;
+}
+
 } // namespace MeshcatCpp::details
 
 #endif // MESHCAT_CPP_MSGPACK_TYPES_H
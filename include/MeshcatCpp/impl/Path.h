@@ -0,0 +1,42 @@
+/**
+ * @file Path.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_PATH_H
+#define MESHCAT_CPP_PATH_H
+
+#include <string>
+#include <string_view>
+
+namespace MeshcatCpp::details
+{
+
+/**
+ * Path of the node that contains the scene. The relative paths are relative to it.
+ */
+constexpr std::string_view scene_prefix = "/meshcat";
+
+/**
+ * Get the canonical form of a path, i.e. the form used to publish it. The path starts with '/'
+ * and the empty segments are removed. A relative path is appended to the prefix.
+ * @param path the path of the node.
+ * @param prefix the absolute path of the node that contains the relative paths.
+ * @return the canonical path. The prefix is returned if the path has no segments.
+ */
+std::string absolute_path(std::string_view path, std::string_view prefix = scene_prefix);
+
+/**
+ * Get the canonical form of a path in a given string. The capacity of the string is reused,
+ * hence no memory is allocated if it is large enough.
+ * @param path the path of the node.
+ * @param prefix the absolute path of the node that contains the relative paths.
+ * @param absolute the canonical path.
+ */
+void absolute_path(std::string_view path, std::string_view prefix, std::string& absolute);
+
+} // namespace MeshcatCpp::details
+
+#endif // MESHCAT_CPP_PATH_H
@@ -0,0 +1,69 @@
+/**
+ * @file PoseKernel.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_POSE_KERNEL_H
+#define MESHCAT_CPP_POSE_KERNEL_H
+
+#include <array>
+#include <cstddef>
+
+namespace MeshcatCpp::details
+{
+
+/**
+ * PoseBlock converts a block of quaternions into rotation matrices. The quaternions and the
+ * rotation matrices are stored as structures of arrays in the block, hence the conversion is a
+ * loop without branches over contiguous arrays that cannot alias, and the compiler vectorizes it.
+ */
+struct PoseBlock
+{
+    static constexpr std::size_t size = 64;
+
+    /**
+     * The components x, y, z and w of the quaternions. The quaternions do not need to be
+     * normalized, but they must be different from zero.
+     */
+    std::array<std::array<double, size>, 4> quaternions;
+
+    /**
+     * The elements of the rotation matrices stored by column, i.e. rotations[3 * col + row][i] is
+     * the element (row, col) of the i-th rotation matrix.
+     */
+    std::array<std::array<double, size>, 9> rotations;
+
+    /**
+     * Compute the rotation matrices associated to the first count quaternions.
+     */
+    void compute_rotations(std::size_t count);
+
+    /**
+     * Fill a column major 4x4 homogeneous transform.
+     * @param index the index of the rotation matrix in the block.
+     * @param x, y, z the position.
+     * @param matrix the homogeneous transform.
+     */
+    void fill_transform(
+        std::size_t index, double x, double y, double z, std::array<double, 16>& matrix) const
+    {
+        for (std::size_t col = 0; col < 3; col++)
+        {
+            for (std::size_t row = 0; row < 3; row++)
+            {
+                matrix[4 * col + row] = this->rotations[3 * col + row][index];
+            }
+            matrix[4 * col + 3] = 0;
+        }
+        matrix[12] = x;
+        matrix[13] = y;
+        matrix[14] = z;
+        matrix[15] = 1;
+    }
+};
+
+} // namespace MeshcatCpp::details
+
+#endif // MESHCAT_CPP_POSE_KERNEL_H
@@ -0,0 +1,103 @@
+/**
+ * @file Recording.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_RECORDING_H
+#define MESHCAT_CPP_RECORDING_H
+
+#include <MeshcatCpp/impl/MappedFile.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MeshcatCpp::details
+{
+
+/**
+ * A recording is a file that starts with the recording_magic string followed by the published
+ * messages. Each message is preceded by the time at which it was published, in nanoseconds since
+ * the beginning of the recording (uint64), and by its size (uint32). The integers are stored with
+ * the byte order of the host.
+ */
+constexpr std::string_view recording_magic = "MCATREC1";
+
+/**
+ * RecordingWriter appends the published messages to a recording. The messages are copied as they
+ * are in a memory mapped file, hence recording a message costs a memcpy.
+ */
+class RecordingWriter
+{
+public:
+    explicit RecordingWriter(const std::string& path);
+
+    void append(std::string_view message);
+
+private:
+    MappedFile file_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * RecordingReader gives access to the messages of a recording. The file is mapped in memory, so
+ * the messages are not copied. A recording truncated by a crash is read up to its last complete
+ * message.
+ */
+class RecordingReader
+{
+public:
+    struct Record
+    {
+        std::uint64_t time;
+        std::string_view message;
+    };
+
+    /**
+     * Constructor.
+     * @param path the path of the recording.
+     * @note std::runtime_error is thrown if the file is not a recording.
+     */
+    explicit RecordingReader(const std::string& path);
+
+    [[nodiscard]] const std::vector<Record>& records() const;
+
+    /**
+     * Get the index of the first record published after a given time.
+     * @param time the time in nanoseconds since the beginning of the recording.
+     */
+    [[nodiscard]] std::size_t upper_bound(std::uint64_t time) const;
+
+private:
+    MappedFile file_;
+    std::vector<Record> records_;
+};
+
+/**
+ * MessageHeader contains the fields of a message that are required to update the scene.
+ */
+struct MessageHeader
+{
+    std::string_view type;
+    std::string_view path;
+    std::string_view property;
+};
+
+/**
+ * Read the type, the path and the property of a packed message without unpacking it. The
+ * fields are looked up among the leading string entries of the message, as they are packed by
+ * Meshcat.
+ * @param message the packed message.
+ * @param header the fields of the message.
+ * @return True if the type of the message is found, false otherwise.
+ */
+bool parse_message_header(std::string_view message, MessageHeader& header);
+
+} // namespace MeshcatCpp::details
+
+#endif // MESHCAT_CPP_RECORDING_H
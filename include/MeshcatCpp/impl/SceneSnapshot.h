@@ -0,0 +1,231 @@
+/**
+ * @file SceneSnapshot.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_SCENE_SNAPSHOT_H
+#define MESHCAT_CPP_SCENE_SNAPSHOT_H
+
+#include <MeshcatCpp/impl/MsgpackTypes.h>
+#include <MeshcatCpp/impl/SharedMessage.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <msgpack.hpp>
+
+namespace MeshcatCpp::details
+{
+
+/**
+ * MessageArena stores a set of messages in a single contiguous buffer. Each message is identified
+ * by a slot. A message replaced by another one with the same size (e.g. a transform) is patched in
+ * place, otherwise the new message is appended and the old one is marked as dead. The buffer is
+ * compacted when the dead messages take more memory than the live ones.
+ */
+class MessageArena
+{
+public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * Store a message.
+     * @param slot the slot of the message. If it is npos a new slot is assigned.
+     * @param msg the message.
+     */
+    void store(std::size_t& slot, std::string_view msg);
+
+    /**
+     * Remove a message.
+     * @param slot the slot of the message. It is set to npos.
+     */
+    void erase(std::size_t& slot);
+
+    /**
+     * Call a function for each message stored in the arena, starting from a given slot. The
+     * messages are visited in the order of their slots.
+     * @param slot the first slot to be visited. When the function returns, it contains the next
+     * slot to be visited.
+     * @param f function having signature bool(std::string_view). If it returns false the visit is
+     * interrupted.
+     * @return True if all the messages are visited, false otherwise.
+     */
+    template <typename F> bool resume(std::size_t& slot, F&& f) const
+    {
+        while (slot < this->offsets_.size())
+        {
+            const std::size_t offset = this->offsets_[slot++];
+            if (offset == npos)
+            {
+                continue;
+            }
+            const Header header = this->header(offset);
+            if (!f(std::string_view(this->data_.data() + offset + sizeof(Header), header.size)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    struct Header
+    {
+        std::uint32_t size;
+        std::uint32_t slot;
+    };
+
+    static constexpr std::uint32_t dead_slot = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::size_t min_compaction_size = 64 * 1024;
+
+    Header header(std::size_t offset) const;
+    void set_header(std::size_t offset, const Header& header);
+    void mark_dead(std::size_t slot);
+    void compact();
+
+    std::string data_;
+    std::vector<std::size_t> offsets_;
+    std::vector<std::size_t> free_slots_;
+    std::size_t dead_bytes_{0};
+};
+
+/**
+ * SnapshotCursor is the position reached by a client that is receiving the snapshot.
+ */
+struct SnapshotCursor
+{
+    enum class Section
+    {
+        Objects,
+        Transforms,
+        Properties,
+        Animation,
+        Done
+    };
+
+    Section section{Section::Objects};
+    std::size_t slot{0};
+
+    [[nodiscard]] bool done() const
+    {
+        return this->section == Section::Done;
+    }
+};
+
+/**
+ * SceneSnapshot contains the messages required to reproduce the scene in a new client. The
+ * messages are stored in contiguous buffers that are patched when the scene changes, so a new
+ * client is initialized without walking the scene tree. The objects are sent first, then the
+ * transforms, the properties and finally the animation.
+ * The snapshot can be sent in several slices through a SnapshotCursor. Since the slices always
+ * contain the latest messages, a client that receives the live updates while it is receiving the
+ * snapshot ends up with the same scene as the others.
+ * @note The snapshot is not thread safe.
+ */
+class SceneSnapshot
+{
+public:
+    static constexpr std::size_t npos = MessageArena::npos;
+
+    void store_object(std::size_t& slot, ObjectMessage&& message);
+
+    /**
+     * Store a set_object message that is not segmented. The message is shared, not copied.
+     */
+    void store_object(std::size_t& slot, SharedMessage msg);
+
+    void store_transform(std::size_t& slot, std::string_view msg);
+
+    void store_property(std::size_t& slot, std::string_view msg);
+
+    void store_animation(SharedMessage msg);
+
+    void erase_animation();
+
+    /**
+     * Remove a message from the snapshot.
+     * @param slot the slot of the message. It is set to npos.
+     */
+    void erase_object(std::size_t& slot);
+
+    void erase_transform(std::size_t& slot);
+
+    void erase_property(std::size_t& slot);
+
+    /**
+     * Call a function for the messages of the snapshot starting from a cursor.
+     * @param cursor the position of the first message. When the function returns, it contains the
+     * position of the next message.
+     * @param buffer the buffer used to join the segments of the set_object messages.
+     * @param f function having signature bool(std::string_view). If it returns false the visit is
+     * interrupted.
+     * @return True if the end of the snapshot is reached, false otherwise.
+     */
+    template <typename F>
+    bool resume(SnapshotCursor& cursor, msgpack::sbuffer& buffer, F&& f) const
+    {
+        using Section = SnapshotCursor::Section;
+
+        if (cursor.section == Section::Objects)
+        {
+            while (cursor.slot < this->objects_.size())
+            {
+                const auto& object = this->objects_[cursor.slot++];
+                if (object && !f(object->view(buffer)))
+                {
+                    return false;
+                }
+            }
+            cursor = SnapshotCursor{.section = Section::Transforms};
+        }
+
+        if (cursor.section == Section::Transforms)
+        {
+            if (!this->transforms_.resume(cursor.slot, f))
+            {
+                return false;
+            }
+            cursor = SnapshotCursor{.section = Section::Properties};
+        }
+
+        if (cursor.section == Section::Properties)
+        {
+            if (!this->properties_.resume(cursor.slot, f))
+            {
+                return false;
+            }
+            cursor = SnapshotCursor{.section = Section::Animation};
+        }
+
+        if (cursor.section == Section::Animation)
+        {
+            cursor = SnapshotCursor{.section = Section::Done};
+            if (!this->animation_.empty() && !f(this->animation_.view()))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    ObjectMessage& object_slot(std::size_t& slot);
+
+    std::vector<std::optional<ObjectMessage>> objects_;
+    std::vector<std::size_t> free_objects_;
+    MessageArena transforms_;
+    MessageArena properties_;
+    SharedMessage animation_;
+};
+
+} // namespace MeshcatCpp::details
+
+#endif // MESHCAT_CPP_SCENE_SNAPSHOT_H
@@ -0,0 +1,334 @@
+/**
+ * @file SceneTree.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_SCENE_TREE_H
+#define MESHCAT_CPP_SCENE_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace MeshcatCpp::details
+{
+
+/**
+ * StringInterner stores each string once and assigns it a compact id. The strings can be looked up
+ * through a std::string_view, hence no memory is allocated to check if a string is interned. The
+ * strings are reference counted, and the id of a string that is not referenced anymore is reused.
+ */
+class StringInterner
+{
+public:
+    using Id = std::uint32_t;
+    static constexpr Id npos = std::numeric_limits<Id>::max();
+
+    /**
+     * Get the id of a string and increase its reference count. If the string is not interned, it
+     * is added.
+     * @param name the string.
+     * @return the id of the string.
+     */
+    Id intern(std::string_view name)
+    {
+        const auto it = this->ids_.find(name);
+        if (it != this->ids_.end())
+        {
+            this->references_[it->second]++;
+            return it->second;
+        }
+
+        Id id;
+        if (!this->free_ids_.empty())
+        {
+            id = this->free_ids_.back();
+            this->free_ids_.pop_back();
+            this->names_[id].assign(name.data(), name.size());
+            this->references_[id] = 1;
+        } else
+        {
+            id = static_cast<Id>(this->names_.size());
+            this->names_.emplace_back(name);
+            this->references_.push_back(1);
+        }
+
+        // std::deque does not move its elements when it grows, so the views stored in ids_ remain
+        // valid.
+        this->ids_.emplace(this->names_[id], id);
+        return id;
+    }
+
+    /**
+     * Decrease the reference count of a string. The string is removed when it is not referenced
+     * anymore.
+     * @param id the id of the string.
+     */
+    void release(Id id)
+    {
+        if (--this->references_[id] > 0)
+        {
+            return;
+        }
+
+        this->ids_.erase(this->names_[id]);
+        std::string().swap(this->names_[id]);
+        this->free_ids_.push_back(id);
+    }
+
+    /**
+     * Get the id of a string without interning it.
+     * @return the id of the string or npos if the string is not interned.
+     */
+    [[nodiscard]] Id find(std::string_view name) const
+    {
+        const auto it = this->ids_.find(name);
+        return it == this->ids_.end() ? npos : it->second;
+    }
+
+    [[nodiscard]] std::string_view name(Id id) const
+    {
+        return this->names_[id];
+    }
+
+private:
+    std::deque<std::string> names_;
+    std::vector<std::uint32_t> references_;
+    std::vector<Id> free_ids_;
+    std::unordered_map<std::string_view, Id> ids_;
+};
+
+/**
+ * SceneTree is a tree whose nodes are stored in a contiguous array and are referred to by their
+ * index. The names of the nodes are interned and the children of all the nodes are stored in a
+ * single hash map indexed by the parent and the name of the child. Hence, looking up a path does
+ * not allocate memory and inserting a node allocates only when a new name is found or when the
+ * containers grow. The indices of the removed nodes are reused, hence each node has a generation
+ * that is increased when the node is removed, so that a stale index can be detected.
+ */
+template <class T> class SceneTree
+{
+public:
+    using Index = std::uint32_t;
+    static constexpr Index root = 0;
+    static constexpr Index npos = std::numeric_limits<Index>::max();
+    static constexpr char separator = '/';
+
+    SceneTree()
+    {
+        this->nodes_.emplace_back();
+    }
+
+    /**
+     * Get the index of the node associated to a path, inserting the missing nodes.
+     * @param path the path of the node relative to the root. Empty segments are ignored.
+     * @return the index of the node.
+     */
+    Index operator[](std::string_view path)
+    {
+        Index node = root;
+        for_each_segment(path, [this, &node](std::string_view segment) {
+            const StringInterner::Id name = this->names_.find(segment);
+            if (name != StringInterner::npos)
+            {
+                const auto it = this->children_.find(edge(node, name));
+                if (it != this->children_.end())
+                {
+                    node = it->second;
+                    return true;
+                }
+            }
+
+            // Each node holds a reference to its name.
+            const StringInterner::Id interned = this->names_.intern(segment);
+            const Index child = this->add_child(node, interned);
+            this->children_.emplace(edge(node, interned), child);
+            node = child;
+            return true;
+        });
+        return node;
+    }
+
+    /**
+     * Get the index of the node associated to a path.
+     * @param path the path of the node relative to the root. Empty segments are ignored.
+     * @return the index of the node or npos if the node does not exist.
+     */
+    [[nodiscard]] Index find(std::string_view path) const
+    {
+        Index node = root;
+        for_each_segment(path, [this, &node](std::string_view segment) {
+            const StringInterner::Id name = this->names_.find(segment);
+            const auto it = name == StringInterner::npos ? this->children_.end()
+                                                          : this->children_.find(edge(node, name));
+            node = it == this->children_.end() ? npos : it->second;
+            return node != npos;
+        });
+        return node;
+    }
+
+    /**
+     * Remove a node and its subtree. The root node cannot be removed, so if node is the root only
+     * its subtree is removed.
+     * @param node the index of the node.
+     * @param f function having signature void(T&), called for each removed node.
+     */
+    template <typename F> void erase(Index node, F&& f)
+    {
+        if (node == root)
+        {
+            while (this->nodes_[root].first_child != npos)
+            {
+                this->erase(this->nodes_[root].first_child, f);
+            }
+            return;
+        }
+
+        this->unlink(node);
+
+        std::vector<Index> stack{node};
+        while (!stack.empty())
+        {
+            const Index current = stack.back();
+            stack.pop_back();
+
+            Entry& entry = this->nodes_[current];
+            for (Index child = entry.first_child; child != npos;
+                 child = this->nodes_[child].next_sibling)
+            {
+                stack.push_back(child);
+            }
+
+            f(entry.value);
+            this->children_.erase(edge(entry.parent, entry.name));
+            this->names_.release(entry.name);
+
+            const std::uint32_t generation = entry.generation + 1;
+            entry = Entry{};
+            entry.generation = generation;
+            this->free_nodes_.push_back(current);
+        }
+    }
+
+    /**
+     * Check if an index refers to a node that has not been removed.
+     * @param node the index of the node.
+     * @param generation the generation of the node when the index was obtained.
+     * @return True if the node exists, false otherwise.
+     */
+    [[nodiscard]] bool contains(Index node, std::uint32_t generation) const
+    {
+        return node < this->nodes_.size() && this->nodes_[node].generation == generation
+               && (node == root || this->nodes_[node].parent != npos);
+    }
+
+    [[nodiscard]] std::uint32_t generation(Index node) const
+    {
+        return this->nodes_[node].generation;
+    }
+
+    T& value(Index node)
+    {
+        return this->nodes_[node].value;
+    }
+
+    const T& value(Index node) const
+    {
+        return this->nodes_[node].value;
+    }
+
+    /**
+     * Get the number of nodes of the tree, including the root.
+     */
+    [[nodiscard]] std::size_t size() const
+    {
+        return this->nodes_.size() - this->free_nodes_.size();
+    }
+
+private:
+    struct Entry
+    {
+        T value{};
+        Index parent{npos};
+        StringInterner::Id name{StringInterner::npos};
+        Index first_child{npos};
+        Index next_sibling{npos};
+        std::uint32_t generation{0};
+    };
+
+    static std::uint64_t edge(Index parent, StringInterner::Id name)
+    {
+        return (static_cast<std::uint64_t>(parent) << 32) | name;
+    }
+
+    /**
+     * Call a function for each non-empty segment of a path until the function returns false.
+     */
+    template <typename F> static void for_each_segment(std::string_view path, F&& f)
+    {
+        while (!path.empty())
+        {
+            const auto loc = path.find(separator);
+            const std::string_view segment = path.substr(0, loc);
+            if (!segment.empty() && !f(segment))
+            {
+                return;
+            }
+            if (loc == std::string_view::npos)
+            {
+                return;
+            }
+            path.remove_prefix(loc + 1);
+        }
+    }
+
+    Index add_child(Index parent, StringInterner::Id name)
+    {
+        Index child;
+        if (!this->free_nodes_.empty())
+        {
+            child = this->free_nodes_.back();
+            this->free_nodes_.pop_back();
+        } else
+        {
+            child = static_cast<Index>(this->nodes_.size());
+            this->nodes_.emplace_back();
+        }
+
+        Entry& entry = this->nodes_[child];
+        entry.parent = parent;
+        entry.name = name;
+        entry.next_sibling = this->nodes_[parent].first_child;
+        this->nodes_[parent].first_child = child;
+        return child;
+    }
+
+    /**
+     * Remove a node from the list of the children of its parent.
+     */
+    void unlink(Index node)
+    {
+        Index* link = &this->nodes_[this->nodes_[node].parent].first_child;
+        while (*link != node)
+        {
+            link = &this->nodes_[*link].next_sibling;
+        }
+        *link = this->nodes_[node].next_sibling;
+    }
+
+    std::vector<Entry> nodes_;
+    std::vector<Index> free_nodes_;
+    StringInterner names_;
+    std::unordered_map<std::uint64_t, Index> children_;
+};
+
+} // namespace MeshcatCpp::details
+
+#endif // MESHCAT_CPP_SCENE_TREE_H
@@ -0,0 +1,67 @@
+/**
+ * @file SharedMessage.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_SHARED_MESSAGE_H
+#define MESHCAT_CPP_SHARED_MESSAGE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace MeshcatCpp::details
+{
+
+/**
+ * SharedMessage is an immutable packed message shared by reference counting. Copying a
+ * SharedMessage does not copy the message, hence the scene snapshot, the pending updates and the
+ * queues of the congested sockets can hold the same large message (e.g. a point cloud) without
+ * increasing the memory.
+ */
+class SharedMessage
+{
+public:
+    SharedMessage() = default;
+
+    explicit SharedMessage(std::string message)
+        : data_(std::make_shared<const std::string>(std::move(message)))
+    {
+    }
+
+    explicit SharedMessage(std::string_view message)
+        : SharedMessage(std::string(message))
+    {
+    }
+
+    [[nodiscard]] std::string_view view() const
+    {
+        return this->data_ != nullptr ? std::string_view(*this->data_) : std::string_view();
+    }
+
+    operator std::string_view() const
+    {
+        return this->view();
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return this->view().size();
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return this->size() == 0;
+    }
+
+private:
+    std::shared_ptr<const std::string> data_;
+};
+
+} // namespace MeshcatCpp::details
+
+#endif // MESHCAT_CPP_SHARED_MESSAGE_H
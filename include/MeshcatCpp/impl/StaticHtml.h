@@ -0,0 +1,61 @@
+/**
+ * @file StaticHtml.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_STATIC_HTML_H
+#define MESHCAT_CPP_STATIC_HTML_H
+
+#include <array>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace MeshcatCpp::details
+{
+
+/**
+ * StaticHtmlWriter writes a self-contained html page that shows a scene without a server. The
+ * page is the one served by Meshcat with main.min.js embedded and the messages of the scene
+ * passed to the viewer as base64 strings. The page is streamed to the file, so only a small
+ * buffer is kept in memory whatever the size of the scene.
+ */
+class StaticHtmlWriter
+{
+public:
+    /**
+     * Constructor. The page is written up to the first message.
+     * @param path the path of the file.
+     * @param index_html the page served by Meshcat.
+     * @param main_min_js the source of the viewer.
+     * @note std::runtime_error is thrown if the file cannot be opened or if index_html does not
+     * contain the expected script tags.
+     */
+    StaticHtmlWriter(const std::string& path,
+                     std::string_view index_html,
+                     std::string_view main_min_js);
+
+    void add_message(std::string_view message);
+
+    /**
+     * Write the end of the page and close the file.
+     * @note std::runtime_error is thrown if the file cannot be written.
+     */
+    void finish();
+
+private:
+    void write(std::string_view text);
+    void flush();
+
+    std::ofstream file_;
+    std::string_view tail_;
+    std::array<char, 64 * 1024> buffer_;
+    std::size_t size_{0};
+};
+
+} // namespace MeshcatCpp::details
+
+#endif // MESHCAT_CPP_STATIC_HTML_H
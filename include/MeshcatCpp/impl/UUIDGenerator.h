@@ -10,6 +10,8 @@
 
 #include <memory>
 #include <random>
+#include <string>
+#include <string_view>
 
 namespace MeshcatCpp::details
 {
@@ -18,6 +20,13 @@ class UUIDGenerator
 {
 public:
     std::string operator()();
+
+    /**
+     * Get the name-based uuid of a name, i.e. the same name always gives the same uuid.
+     * @param name the name.
+     * @return the uuid.
+     */
+    static std::string from_name(std::string_view name);
     static UUIDGenerator& generator();
 
 private:
@@ -0,0 +1,134 @@
+/**
+ * @file Animation.cpp
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#include <MeshcatCpp/Animation.h>
+#include <MeshcatCpp/impl/Path.h>
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+using namespace MeshcatCpp;
+
+namespace
+{
+
+/**
+ * Compute the quaternion (x, y, z, w) associated to the rotational part of a homogeneous
+ * transform. The columns are normalized so that a scaled rotation is accepted.
+ */
+std::array<double, 4> rotation_to_quaternion(const MatrixView<const double>& matrix)
+{
+    std::array<std::array<double, 3>, 3> r;
+    for (MatrixView<const double>::index_type j = 0; j < 3; j++)
+    {
+        const double norm = std::sqrt(matrix(0, j) * matrix(0, j) + matrix(1, j) * matrix(1, j)
+                                      + matrix(2, j) * matrix(2, j));
+        for (MatrixView<const double>::index_type i = 0; i < 3; i++)
+        {
+            r[i][j] = norm > 0 ? matrix(i, j) / norm : 0;
+        }
+    }
+
+    const double trace = r[0][0] + r[1][1] + r[2][2];
+    if (trace > 0)
+    {
+        const double s = 0.5 / std::sqrt(trace + 1.0);
+        return {(r[2][1] - r[1][2]) * s,
+                (r[0][2] - r[2][0]) * s,
+                (r[1][0] - r[0][1]) * s,
+                0.25 / s};
+    }
+    if (r[0][0] > r[1][1] && r[0][0] > r[2][2])
+    {
+        const double s = 2.0 * std::sqrt(1.0 + r[0][0] - r[1][1] - r[2][2]);
+        return {0.25 * s,
+                (r[0][1] + r[1][0]) / s,
+                (r[0][2] + r[2][0]) / s,
+                (r[2][1] - r[1][2]) / s};
+    }
+    if (r[1][1] > r[2][2])
+    {
+        const double s = 2.0 * std::sqrt(1.0 + r[1][1] - r[0][0] - r[2][2]);
+        return {(r[0][1] + r[1][0]) / s,
+                0.25 * s,
+                (r[1][2] + r[2][1]) / s,
+                (r[0][2] - r[2][0]) / s};
+    }
+    const double s = 2.0 * std::sqrt(1.0 + r[2][2] - r[0][0] - r[1][1]);
+    return {(r[0][2] + r[2][0]) / s, (r[1][2] + r[2][1]) / s, 0.25 * s, (r[1][0] - r[0][1]) / s};
+}
+
+} // namespace
+
+Animation::Animation(double fps)
+    : fps_(fps)
+{
+    if (fps <= 0)
+    {
+        throw std::runtime_error("The number of frames per second must be positive.");
+    }
+}
+
+void Animation::set_transform(std::size_t frame,
+                              std::string_view path,
+                              const MatrixView<const double>& matrix)
+{
+    if (matrix.rows() != 4 || matrix.cols() != 4)
+    {
+        throw std::runtime_error("The transform must be a 4x4 matrix.");
+    }
+
+    // The clips are stored by absolute path, so that the different forms of a path (e.g. "box"
+    // and "/meshcat/box/") refer to the same clip.
+    const std::string absolute_path = details::absolute_path(path);
+    auto it = this->clips_.find(absolute_path);
+    if (it == this->clips_.end())
+    {
+        it = this->clips_.emplace(absolute_path, Clip{}).first;
+    }
+    Clip& clip = it->second;
+
+    const auto time = static_cast<float>(frame);
+    if (!clip.times.empty() && time < clip.times.back())
+    {
+        throw std::runtime_error("The frames of a path must be set in non-decreasing order.");
+    }
+
+    // A keyframe set on the last frame replaces the previous one.
+    if (!clip.times.empty() && time == clip.times.back())
+    {
+        clip.times.pop_back();
+        clip.positions.resize(clip.positions.size() - 3);
+        clip.quaternions.resize(clip.quaternions.size() - 4);
+    }
+
+    clip.times.push_back(time);
+    for (MatrixView<const double>::index_type i = 0; i < 3; i++)
+    {
+        clip.positions.push_back(static_cast<float>(matrix(i, 3)));
+    }
+    for (const double value : rotation_to_quaternion(matrix))
+    {
+        clip.quaternions.push_back(static_cast<float>(value));
+    }
+}
+
+double Animation::fps() const
+{
+    return this->fps_;
+}
+
+bool Animation::empty() const
+{
+    return this->clips_.empty();
+}
+
+const std::map<std::string, Animation::Clip, std::less<>>& Animation::clips() const
+{
+    return this->clips_;
+}
@@ -0,0 +1,246 @@
+/**
+ * @file MappedFile.cpp
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#include <MeshcatCpp/impl/MappedFile.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace MeshcatCpp::details;
+
+namespace
+{
+constexpr std::size_t initial_capacity = 16 * 1024 * 1024;
+} // namespace
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path, Mode mode)
+    : mode_(mode)
+{
+    const bool write = mode == Mode::Write;
+    HANDLE file = CreateFileA(path.c_str(),
+                              write ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              write ? CREATE_ALWAYS : OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Unable to open the file " + path);
+    }
+    this->file_ = file;
+
+    LARGE_INTEGER size;
+    if (!write && !GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Unable to get the size of the file " + path);
+    }
+
+    try
+    {
+        if (write)
+        {
+            this->map(initial_capacity);
+        } else
+        {
+            this->size_ = static_cast<std::size_t>(size.QuadPart);
+            this->map(this->size_);
+        }
+    } catch (...)
+    {
+        CloseHandle(file);
+        throw;
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    this->unmap();
+    if (this->mode_ == Mode::Write)
+    {
+        LARGE_INTEGER size;
+        size.QuadPart = static_cast<LONGLONG>(this->size_);
+        SetFilePointerEx(this->file_, size, nullptr, FILE_BEGIN);
+        SetEndOfFile(this->file_);
+    }
+    CloseHandle(this->file_);
+}
+
+void MappedFile::map(std::size_t capacity)
+{
+    this->capacity_ = capacity;
+    if (capacity == 0)
+    {
+        return;
+    }
+
+    const bool write = this->mode_ == Mode::Write;
+    const auto size = static_cast<unsigned long long>(capacity);
+    this->mapping_ = CreateFileMappingA(this->file_,
+                                        nullptr,
+                                        write ? PAGE_READWRITE : PAGE_READONLY,
+                                        static_cast<DWORD>(size >> 32),
+                                        static_cast<DWORD>(size & 0xFFFFFFFF),
+                                        nullptr);
+    if (this->mapping_ == nullptr)
+    {
+        throw std::runtime_error("Unable to map the file.");
+    }
+
+    this->data_ = static_cast<char*>(
+        MapViewOfFile(this->mapping_, write ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, capacity));
+    if (this->data_ == nullptr)
+    {
+        CloseHandle(this->mapping_);
+        this->mapping_ = nullptr;
+        throw std::runtime_error("Unable to map the file.");
+    }
+}
+
+void MappedFile::unmap()
+{
+    if (this->data_ != nullptr)
+    {
+        UnmapViewOfFile(this->data_);
+        this->data_ = nullptr;
+    }
+    if (this->mapping_ != nullptr)
+    {
+        CloseHandle(this->mapping_);
+        this->mapping_ = nullptr;
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path, Mode mode)
+    : mode_(mode)
+{
+    const bool write = mode == Mode::Write;
+    this->fd_ = write ? ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)
+                      : ::open(path.c_str(), O_RDONLY);
+    if (this->fd_ < 0)
+    {
+        throw std::runtime_error("Unable to open the file " + path);
+    }
+
+    struct stat status;
+    if (!write && ::fstat(this->fd_, &status) != 0)
+    {
+        ::close(this->fd_);
+        throw std::runtime_error("Unable to get the size of the file " + path);
+    }
+
+    try
+    {
+        if (write)
+        {
+            this->map(initial_capacity);
+        } else
+        {
+            this->size_ = static_cast<std::size_t>(status.st_size);
+            this->map(this->size_);
+        }
+    } catch (...)
+    {
+        ::close(this->fd_);
+        throw;
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    this->unmap();
+    if (this->mode_ == Mode::Write)
+    {
+        // The space reserved for the mapping is released.
+        [[maybe_unused]] const int result = ::ftruncate(this->fd_, static_cast<off_t>(this->size_));
+    }
+    ::close(this->fd_);
+}
+
+void MappedFile::map(std::size_t capacity)
+{
+    this->capacity_ = capacity;
+    if (capacity == 0)
+    {
+        return;
+    }
+
+    const bool write = this->mode_ == Mode::Write;
+    if (write && ::ftruncate(this->fd_, static_cast<off_t>(capacity)) != 0)
+    {
+        throw std::runtime_error("Unable to resize the file.");
+    }
+
+    void* data = ::mmap(nullptr,
+                        capacity,
+                        write ? PROT_READ | PROT_WRITE : PROT_READ,
+                        MAP_SHARED,
+                        this->fd_,
+                        0);
+    if (data == MAP_FAILED)
+    {
+        throw std::runtime_error("Unable to map the file.");
+    }
+    this->data_ = static_cast<char*>(data);
+}
+
+void MappedFile::unmap()
+{
+    if (this->data_ != nullptr)
+    {
+        ::munmap(this->data_, this->capacity_);
+        this->data_ = nullptr;
+    }
+}
+
+#endif
+
+void MappedFile::append(const void* data, std::size_t size)
+{
+    if (this->mode_ != Mode::Write)
+    {
+        throw std::runtime_error("The file is not opened for writing.");
+    }
+
+    if (this->size_ + size > this->capacity_)
+    {
+        const std::size_t capacity = std::max(2 * this->capacity_, this->size_ + size);
+        this->unmap();
+        this->map(capacity);
+    }
+
+    std::memcpy(this->data_ + this->size_, data, size);
+    this->size_ += size;
+}
+
+const char* MappedFile::data() const
+{
+    return this->data_;
+}
+
+std::size_t MappedFile::size() const
+{
+    return this->size_;
+}
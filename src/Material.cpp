@@ -28,8 +28,19 @@ Material Material::get_default_material()
                  .linewidth = 1.0,
                  .wireframe = false,
                  .wireframeLineWidth = 1.0,
+                 .size = std::nullopt,
                  .vertexColors = false,
                  .type = Material::Type::MeshPhongMaterial};
 
     return tmp;
 }
+
+Material Material::get_default_points_material()
+{
+    Material tmp;
+    tmp.size = 0.001;
+    tmp.vertexColors = true;
+    tmp.type = Material::Type::PointsMaterial;
+
+    return tmp;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file MeshFileCache.cpp
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#include <MeshcatCpp/impl/MeshFileCache.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+using namespace MeshcatCpp::details;
+
+MeshFileCache& MeshFileCache::cache()
+{
+    static MeshFileCache instance;
+    return instance;
+}
+
+MeshFileCache::File MeshFileCache::stat(const std::string& path)
+{
+    File file;
+    std::error_code ec;
+    const auto last_write_time = std::filesystem::last_write_time(path, ec);
+    if (ec)
+    {
+        return file;
+    }
+    const auto size = std::filesystem::file_size(path, ec);
+    if (ec)
+    {
+        return file;
+    }
+    file.last_write_time = last_write_time;
+    file.size = size;
+
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    auto it = this->entries_.find(path);
+    if (it != this->entries_.end() && it->second.last_write_time == last_write_time
+        && it->second.size == size)
+    {
+        file.data = it->second.data.lock();
+    }
+    return file;
+}
+
+MeshFileCache::File MeshFileCache::load(const std::string& path)
+{
+    File file = this->stat(path);
+    if (file.data != nullptr)
+    {
+        return file;
+    }
+    const auto last_write_time = file.last_write_time;
+    const auto size = file.size;
+
+    // The file is read without holding the lock so that loading a large mesh does not block the
+    // threads that are requesting other files.
+    std::ifstream input(path, std::ios::binary);
+    if (!input.is_open())
+    {
+        return {};
+    }
+
+    auto data = std::make_shared<std::vector<char>>(size);
+    input.read(data->data(), size);
+    data->resize(input.gcount());
+
+    Buffer buffer = std::move(data);
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->remove_expired();
+    auto& entry = this->entries_[path];
+    if (entry.last_write_time == last_write_time && entry.size == size)
+    {
+        if (auto existing = entry.data.lock())
+        {
+            // Another thread read the same file in the meantime.
+            return File{std::move(existing), last_write_time, size};
+        }
+    }
+    entry = Entry{last_write_time, size, buffer};
+    return File{std::move(buffer), last_write_time, size};
+}
+
+void MeshFileCache::remove_expired()
+{
+    if (this->entries_.size() < this->sweep_size_)
+    {
+        return;
+    }
+
+    for (auto it = this->entries_.begin(); it != this->entries_.end();)
+    {
+        it = it->second.data.expired() ? this->entries_.erase(it) : std::next(it);
+    }
+    this->sweep_size_ = std::max(min_sweep_size, 2 * this->entries_.size());
+}
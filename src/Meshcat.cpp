@@ -5,21 +5,41 @@
  * license.
  */
 
+#include <MeshcatCpp/Animation.h>
 #include <MeshcatCpp/Material.h>
 #include <MeshcatCpp/MatrixView.h>
 #include <MeshcatCpp/Meshcat.h>
+#include <MeshcatCpp/Model.h>
 #include <MeshcatCpp/Property.h>
 #include <MeshcatCpp/Shape.h>
 
+#include <MeshcatCpp/impl/CommandQueue.h>
+#include <MeshcatCpp/impl/DefinitionCache.h>
 #include <MeshcatCpp/impl/FindResource.h>
 #include <MeshcatCpp/impl/MsgpackTypes.h>
-#include <MeshcatCpp/impl/TreeNode.h>
+#include <MeshcatCpp/impl/Path.h>
+#include <MeshcatCpp/impl/PoseKernel.h>
+#include <MeshcatCpp/impl/Recording.h>
+#include <MeshcatCpp/impl/SceneSnapshot.h>
+#include <MeshcatCpp/impl/SceneTree.h>
+#include <MeshcatCpp/impl/SharedMessage.h>
+#include <MeshcatCpp/impl/StaticHtml.h>
 #include <MeshcatCpp/impl/UUIDGenerator.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstddef>
+#include <cstring>
+#include <deque>
 #include <fstream>
 #include <future>
+#include <iostream>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -27,6 +47,7 @@
 #include <thread>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <variant>
 
@@ -41,93 +62,314 @@
 #include <cmrc/cmrc.hpp>
 CMRC_DECLARE(MeshcatCpp);
 
+namespace MeshcatCpp
+{
+
+constexpr static bool use_ssl = false;
+constexpr static bool is_server = true;
+
+/**
+ * PerSocketData contains the transforms, the properties and the object updates (e.g. point clouds
+ * streamed at sensor rate) that have not been sent to a congested socket. Only the latest message
+ * of each path (and property) is kept and the messages are sent once the socket drains. Moreover,
+ * it stores the position of the socket in the scene snapshot while the scene is being sent.
+ */
+struct PerSocketData
+{
+    // Position reached by the socket while it receives the scene.
+    details::SnapshotCursor snapshot_cursor;
+
+    std::unordered_map<std::string, std::string> pending_transforms;
+    std::map<std::pair<std::string, std::string>, std::string> pending_properties;
+    std::unordered_map<std::string, details::SharedMessage> pending_objects;
+
+    [[nodiscard]] bool has_pending_messages() const
+    {
+        return !this->pending_transforms.empty() || !this->pending_properties.empty()
+               || !this->pending_objects.empty();
+    }
+};
+
+using WebSocket = uWS::WebSocket<use_ssl, is_server, PerSocketData>;
+
+struct Node
+{
+    // Slot of the msgpack'd set_object command in the scene snapshot.
+    std::size_t object{details::SceneSnapshot::npos};
+    // Slot of the msgpack'd set_transform command in the scene snapshot.
+    std::size_t transform{details::SceneSnapshot::npos};
+    // Slots of the msgpack'd set_property command(s) in the scene snapshot, together with the
+    // interned names of the properties.
+    std::vector<std::pair<details::StringInterner::Id, std::size_t>> properties;
+};
+
+using Tree = details::SceneTree<Node>;
+
+} // namespace MeshcatCpp
+
 namespace MeshcatCpp::details
 {
 
-struct TransformData
+struct NodeHandleData
 {
-    std::string type{"set_transform"};
+    // The absolute path of the node.
     std::string path;
+    // The msgpack'd set_transform command up to the values of the matrix, i.e. the map, the type,
+    // the path and the header of the matrix. It is packed once, then only the values are packed
+    // when the transform changes.
+    std::string transform_header;
+    // The index of the node in the scene tree. It is resolved the first time the handle is used
+    // and it should only be accessed from the websocket_thread.
+    Tree::Index node{Tree::npos};
+    // The generation of the node, used to detect if the node has been deleted.
+    std::uint32_t generation{0};
+};
+
+/**
+ * Pack the part of the set_transform command of a node that does not depend on the matrix.
+ * @param path the absolute path of the node.
+ * @param use_float32 if true the matrix is packed as a Float32Array, otherwise as an array of
+ * float64.
+ */
+inline std::string pack_transform_header(const std::string& path, bool use_float32)
+{
+    constexpr std::uint32_t size = 16;
+
+    std::string header;
+    StringBuffer buffer{header};
+    msgpack::packer<StringBuffer> o(buffer);
+    o.pack_map(3);
+    o.pack("type");
+    o.pack("set_transform");
+    o.pack("path");
+    o.pack(path);
+    o.pack("matrix");
+    if (use_float32)
+    {
+        o.pack_ext(size * sizeof(float), typed_array_ext_type<float>::value);
+    } else
+    {
+        o.pack_array(size);
+    }
+    return header;
+}
+
+/**
+ * Store a msgpack float64, i.e. the 0xcb marker followed by the big endian representation of the
+ * value.
+ */
+inline void store_float64(char* output, double value)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    output[0] = static_cast<char>(0xcb);
+    for (int i = 0; i < 8; i++)
+    {
+        output[1 + i] = static_cast<char>(bits >> (56 - 8 * i));
+    }
+}
+
+template <typename Scalar>
+using TransformView = FixedMatrixView<Scalar, 4, 4, MatrixStorageOrdering::ColumnMajor>;
+
+struct TransformData
+{
+    std::shared_ptr<NodeHandleData> node;
     std::array<double, 16> matrix;
-    MSGPACK_DEFINE_MAP(type, path, matrix);
 
-    MeshcatCpp::MatrixView<double> transform();
-    MeshcatCpp::MatrixView<const double> transform() const;
+    TransformView<double> transform();
+    TransformView<const double> transform() const;
+
+    template <typename Scalar> void set_transform(const MatrixView<const Scalar>& matrix)
+    {
+        // The storage ordering of the matrix is checked once, then it is copied as a fixed size
+        // matrix.
+        this->transform().copy_from(matrix);
+    }
+
+    /**
+     * Pack the set_transform command. Only the values of the matrix are packed, the rest of the
+     * message is copied from the header stored in the node handle.
+     * @param stream the output buffer.
+     * @param use_float32 if true the matrix is packed as a Float32Array, otherwise as an array of
+     * float64. It must match the header of the node handle.
+     */
+    template <typename Stream> void pack(Stream& stream, bool use_float32) const
+    {
+        const std::string& header = this->node->transform_header;
+        stream.write(header.data(), header.size());
+        if (use_float32)
+        {
+            // The typed arrays are stored with the byte order of the host, as in
+            // pack_typed_array().
+            std::array<float, 16> values;
+            std::copy(this->matrix.begin(), this->matrix.end(), values.begin());
+            stream.write(reinterpret_cast<const char*>(values.data()), sizeof(values));
+        } else
+        {
+            constexpr std::size_t float64_size = 1 + sizeof(double);
+            std::array<char, 16 * float64_size> values;
+            for (std::size_t i = 0; i < this->matrix.size(); i++)
+            {
+                store_float64(values.data() + i * float64_size, this->matrix[i]);
+            }
+            stream.write(values.data(), values.size());
+        }
+    }
 };
 
-MeshcatCpp::MatrixView<double> TransformData::transform()
+TransformView<double> TransformData::transform()
 {
-    constexpr MatrixView<double>::index_type rows = 4;
-    constexpr MatrixView<double>::index_type cols = 4;
-    constexpr auto order = MeshcatCpp::MatrixStorageOrdering::ColumnMajor;
-    return make_matrix_view(this->matrix.data(), rows, cols, order);
+    return TransformView<double>(this->matrix.data());
 }
 
-MeshcatCpp::MatrixView<const double> TransformData::transform() const
+TransformView<const double> TransformData::transform() const
 {
-    constexpr MatrixView<const double>::index_type rows = 4;
-    constexpr MatrixView<const double>::index_type cols = 4;
-    constexpr auto order = MeshcatCpp::MatrixStorageOrdering::ColumnMajor;
-    return make_matrix_view(this->matrix.data(), rows, cols, order);
+    return TransformView<const double>(this->matrix.data());
 }
 
-template <typename T> struct PropertyTrampoline : public ::MeshcatCpp::Property<T>
+/**
+ * ModelData contains a published model, the nodes of its links and the joint positions that have
+ * been published last. The links are nested as in the model, hence the transform of a link depends
+ * only on the position of its joint.
+ */
+struct ModelData
 {
-    // TOFO make it const
-    std::string type{"set_property"};
+    explicit ModelData(const Model& model)
+        : model(model)
+    {
+    }
 
-    MSGPACK_DEFINE_MAP(type,
-                       MSGPACK_NVP("path", ::MeshcatCpp::Property<T>::path),
-                       MSGPACK_NVP("property", ::MeshcatCpp::Property<T>::property),
-                       MSGPACK_NVP("value", ::MeshcatCpp::Property<T>::value));
+    const Model model;
+    std::vector<std::shared_ptr<NodeHandleData>> links;
+
+    // Protects the joint positions, the model can be updated by several threads.
+    std::mutex mutex;
+    std::vector<double> positions;
 };
 
-} // namespace MeshcatCpp::details
+struct PropertyMessage
+{
+    std::shared_ptr<NodeHandleData> node;
+    std::string property;
+    // The msgpack'd set_property command.
+    std::string message;
+};
 
-namespace MeshcatCpp
+/**
+ * Check if a path refers to a node of the subtree rooted at another path.
+ */
+inline bool is_in_subtree(std::string_view path, std::string_view root)
 {
+    return path.size() >= root.size() && path.compare(0, root.size(), root) == 0
+           && (path.size() == root.size() || path[root.size()] == Tree::separator);
+}
 
-constexpr static bool use_ssl = false;
-constexpr static bool is_server = true;
+inline const std::string& path_of(const std::string& key)
+{
+    return key;
+}
 
-using PerSocketData = std::monostate;
+inline const std::string& path_of(const std::pair<std::string, std::string>& key)
+{
+    return key.first;
+}
 
-using WebSocket = uWS::WebSocket<use_ssl, is_server, PerSocketData>;
+/**
+ * Remove the elements of a map, keyed by path or by path and property, whose path belongs to the
+ * subtree rooted at a given path.
+ */
+template <typename Map> void erase_subtree(Map& map, std::string_view root)
+{
+    for (auto it = map.begin(); it != map.end();)
+    {
+        it = is_in_subtree(path_of(it->first), root) ? map.erase(it) : std::next(it);
+    }
+}
 
-struct Node
+/**
+ * PendingUpdates stores the transforms, the properties and the object updates that are not
+ * published yet. Only the latest value of each path (and property) is kept.
+ */
+struct PendingUpdates
 {
-    // The msgpack'd set_object command.
-    std::optional<std::string> object;
-    // The msgpack'd set_transform command.
-    std::optional<std::string> transform;
-    // The msgpack'd set_property command(s).
-    std::map<std::string, std::string> properties;
+    std::unordered_map<std::string, TransformData> transforms;
+    std::map<std::pair<std::string, std::string>, PropertyMessage> properties;
+    // The msgpack'd set_object commands.
+    std::unordered_map<std::string, SharedMessage> objects;
 
-    void send(WebSocket* ws) const
+    [[nodiscard]] bool empty() const
     {
-        if (this->object)
-        {
-            ws->send(this->object.value());
-        }
-        if (this->transform)
-        {
-            ws->send(this->transform.value());
-        }
-        for (const auto& [property, msg] : this->properties)
-        {
-            ws->send(msg);
-        }
+        return this->transforms.empty() && this->properties.empty() && this->objects.empty();
+    }
+
+    void clear()
+    {
+        this->transforms.clear();
+        this->properties.clear();
+        this->objects.clear();
+    }
+
+    /**
+     * Remove the updates of the nodes belonging to the subtree rooted at a given path.
+     */
+    void erase_subtree(std::string_view root)
+    {
+        details::erase_subtree(this->transforms, root);
+        details::erase_subtree(this->properties, root);
+        details::erase_subtree(this->objects, root);
     }
 };
 
+/**
+ * Command is a record of the queue shared by the caller threads and the websocket_thread.
+ */
+struct Command
+{
+    enum class Type
+    {
+        Transform,
+        Task
+    };
+
+    Type type{Type::Task};
+    // The transforms are stored in the record, so that updating a transform does not allocate.
+    TransformData transform;
+    // Any other command is stored as a task executed in the websocket_thread.
+    uWS::MoveOnlyFunction<void()> task;
+};
+
+template <typename T> struct PropertyTrampoline : public ::MeshcatCpp::Property<T>
+{
+    // TOFO make it const
+    std::string type{"set_property"};
+
+    MSGPACK_DEFINE_MAP(type,
+                       MSGPACK_NVP("path", ::MeshcatCpp::Property<T>::path),
+                       MSGPACK_NVP("property", ::MeshcatCpp::Property<T>::property),
+                       MSGPACK_NVP("value", ::MeshcatCpp::Property<T>::value));
+};
+
+} // namespace MeshcatCpp::details
+
+namespace MeshcatCpp
+{
+
 class Meshcat::Impl
 {
 public:
     Impl& operator=(const Impl&) = delete;
     Impl(const Impl&) = delete;
 
-    Impl()
+    Impl(const MeshcatParams& params)
+        : params_(params)
+        , commands_(params.command_queue_capacity)
     {
+        if (!params.recording_path.empty())
+        {
+            this->recorder_ = std::make_unique<details::RecordingWriter>(params.recording_path);
+        }
+
         if (!this->load_file("misc/index.html", this->index_html_))
         {
             throw std::runtime_error("Unable to load index.html");
@@ -143,30 +385,64 @@ public:
             throw std::runtime_error("Unable to load main.min.js");
         }
 
-        this->root_ = std::make_shared<MeshcatCpp::details::TreeNode<Node>>();
         this->app_future_ = app_promise_.get_future();
     }
 
     ~Impl()
     {
-        loop_->defer([this]() { us_listen_socket_close(0, this->listen_socket_); });
+        loop_->defer([this]() {
+            if (this->publish_timer_ != nullptr)
+            {
+                us_timer_close(this->publish_timer_);
+            }
+            if (this->replay_timer_ != nullptr)
+            {
+                us_timer_close(this->replay_timer_);
+            }
+            if (this->keep_alive_timer_ != nullptr)
+            {
+                us_timer_close(this->keep_alive_timer_);
+            }
+            if (this->listen_socket_ != nullptr)
+            {
+                us_listen_socket_close(0, this->listen_socket_);
+            }
+        });
         this->websocket_thread_.join();
     }
 
     void websocket_main()
     {
+        this->websocket_thread_id_ = std::this_thread::get_id();
+
+        if (this->params_.transport == MeshcatParams::Transport::Headless)
+        {
+            this->headless_main();
+            return;
+        }
+
         int port = 7001;
         const int kMaxPort = 7099;
 
         uWS::App::WebSocketBehavior<PerSocketData> behavior;
 
         // Set maxBackpressure = 0 so that uWS does *not* drop any messages due to
-        // back pressure.
+        // back pressure. The stale transforms and properties are dropped by send_transform() and
+        // send_property() according to params_.max_socket_backpressure.
         behavior.maxBackpressure = 0;
         behavior.open = [this](WebSocket* ws) {
-            ws->subscribe("all");
+            this->sockets_.insert(ws);
             // Update this new connection with previously published data.
-            this->send_tree(ws, this->root_);
+            this->syncing_sockets_.insert(ws);
+            this->send_snapshot(ws);
+        };
+        behavior.drain = [this](WebSocket* ws) {
+            this->send_pending_messages(ws);
+            this->send_snapshot(ws);
+        };
+        behavior.close = [this](WebSocket* ws, int /*code*/, std::string_view /*message*/) {
+            this->sockets_.erase(ws);
+            this->syncing_sockets_.erase(ws);
         };
 
         uWS::App app = uWS::App()
@@ -200,6 +476,7 @@ public:
                        });
         } while (listen_socket == nullptr && port++ <= kMaxPort);
 
+        this->start_publish_timer(uWS::Loop::get());
         this->set_app_promise(&app, uWS::Loop::get(), port, listen_socket);
 
         app.run();
@@ -208,6 +485,30 @@ public:
         throw std::runtime_error("Meshcat websocket thread failed");
     }
 
+    /**
+     * Run the event loop without a server. The loop is only used to execute the commands and the
+     * timers, the messages are passed to the message sink.
+     */
+    void headless_main()
+    {
+        uWS::Loop* loop = uWS::Loop::get();
+
+        // The loop runs as long as it has an active timer. The keep alive timer does nothing and
+        // it is closed by the destructor.
+        constexpr int keep_alive_period_ms = 60 * 60 * 1000;
+        this->keep_alive_timer_ = us_create_timer(reinterpret_cast<us_loop_t*>(loop), 0, 0);
+        us_timer_set(
+            this->keep_alive_timer_,
+            [](us_timer_t*) {},
+            keep_alive_period_ms,
+            keep_alive_period_ms);
+
+        this->start_publish_timer(loop);
+        this->set_app_promise(nullptr, loop, -1, nullptr);
+
+        loop->run();
+    }
+
     void get_app_future()
     {
         std::tie(this->app_, this->loop_, this->port_, this->listen_socket_)
@@ -217,165 +518,1470 @@ public:
     template <typename T>
     void set_property(const Property<T>& property)
     {
-        details::PropertyTrampoline<T> data{property};
-        this->loop_->defer([this, data = std::move(data)]() {
-            std::stringstream message_stream;
-            msgpack::pack(message_stream, data);
-            const std::string msg = message_stream.str();
-            this->app_->publish("all", msg, uWS::OpCode::BINARY, false);
-            (*this->root_)[data.path]->value().properties[data.property] = std::move(msg);
-        });
+        this->set_property(this->node_handle(property.path), property.property, property.value);
+    }
+
+    std::shared_ptr<details::NodeHandleData> make_node_handle(std::string_view path) const
+    {
+        auto node = std::make_shared<details::NodeHandleData>();
+        node->path = this->absolute_path(path);
+
+        node->transform_header
+            = details::pack_transform_header(node->path, this->params_.float32_transforms);
+        return node;
+    }
+
+    /**
+     * Get the handle of a node updated by path. The handles are cached, hence once a path is used
+     * its handle is found without allocating memory.
+     */
+    std::shared_ptr<details::NodeHandleData> node_handle(std::string_view path) const
+    {
+        // The path is normalized in a buffer owned by the calling thread.
+        thread_local std::string absolute;
+        details::absolute_path(path, this->prefix_, absolute);
+
+        std::lock_guard<std::mutex> lock(this->handles_mutex_);
+        return this->cached_node_handle(absolute);
+    }
+
+    std::vector<std::shared_ptr<details::NodeHandleData>>
+    node_handles(const std::vector<std::string>& paths) const
+    {
+        thread_local std::string absolute;
+        std::vector<std::shared_ptr<details::NodeHandleData>> nodes;
+        nodes.reserve(paths.size());
+
+        std::lock_guard<std::mutex> lock(this->handles_mutex_);
+        for (const auto& path : paths)
+        {
+            details::absolute_path(path, this->prefix_, absolute);
+            nodes.push_back(this->cached_node_handle(absolute));
+        }
+        return nodes;
+    }
+
+    /**
+     * Find the handle of an absolute path in the cache, or create it. It must be called with
+     * handles_mutex_ locked.
+     */
+    std::shared_ptr<details::NodeHandleData> cached_node_handle(const std::string& path) const
+    {
+        const auto it = this->handles_.find(path);
+        if (it != this->handles_.end())
+        {
+            return it->second;
+        }
+
+        // The handles that are not used anymore are removed when the cache grows. Since a handle
+        // is obtained only through the cache, a handle referenced only by the cache stays unused.
+        if (this->handles_.size() >= this->handles_sweep_size_)
+        {
+            for (auto entry = this->handles_.begin(); entry != this->handles_.end();)
+            {
+                entry = entry->second.use_count() == 1 ? this->handles_.erase(entry)
+                                                       : std::next(entry);
+            }
+            this->handles_sweep_size_
+                = std::max(handles_min_sweep_size, 2 * this->handles_.size());
+        }
+
+        auto node = std::make_shared<details::NodeHandleData>();
+        node->path = path;
+        node->transform_header
+            = details::pack_transform_header(node->path, this->params_.float32_transforms);
+        this->handles_.emplace(path, node);
+        return node;
     }
 
     template <typename T>
-    void set_property(std::string_view path, const std::string& property, const T& value)
+    void set_property(std::shared_ptr<details::NodeHandleData> node,
+                      const std::string& property,
+                      const T& value)
     {
         details::PropertyTrampoline<T> data{
-            {.path = this->absolute_path(path), .property = property, .value = value}};
-
-        this->loop_->defer([this, data = std::move(data)]() {
-            std::stringstream message_stream;
-            msgpack::pack(message_stream, data);
-            const std::string msg = message_stream.str();
-            this->app_->publish("all", msg, uWS::OpCode::BINARY, false);
-            (*this->root_)[data.path]->value().properties[data.property] = std::move(msg);
+            {.path = node->path, .property = property, .value = value}};
+
+        // The message is packed by the calling thread, the websocket_thread only publishes it.
+        details::PropertyMessage message;
+        message.node = std::move(node);
+        message.property = property;
+        pack_to_string(data, message.message);
+
+        if (this->conflates_updates())
+        {
+            std::lock_guard<std::mutex> lock(this->pending_mutex_);
+            this->pending_.properties[{data.path, data.property}] = std::move(message);
+            this->notify_pending_updates();
+            return;
+        }
+
+        this->enqueue_task([this, message = std::move(message)]() {
+            this->publish_property(message.node->path, message.property, message.message);
+            this->snapshot_.store_property(
+                this->property_slot(this->resolve(*message.node), message.property),
+                message.message);
         });
     }
 
-
     template <typename T>
-    void set_object(std::string_view path, const T& shape, const Material& material)
+    details::SetObjectData<typename details::traits<T>::trampoline>
+    make_set_object_data(std::string_view path, const T& shape, const Material& material) const
     {
         static_assert(std::is_base_of_v<::MeshcatCpp::Shape, T>, "Invalid shape type");
 
-        details::SetObjectData data{.path = this->absolute_path(path)};
+        using Geometry = typename details::traits<T>::trampoline;
+        details::SetObjectData<Geometry> data;
+        data.path = this->absolute_path(path);
         data.object.material = std::make_unique<details::MaterialTrampoline>(material);
-        data.object.geometry = std::make_unique<typename details::traits<T>::trampoline>(shape);
-        data.object.object.type = "Mesh";
+        data.object.geometry = std::make_unique<Geometry>(shape);
         data.object.object.material = data.object.material->uuid;
         data.object.object.geometry = data.object.geometry->uuid;
+        data.object.object.update_type_from_shape(shape);
         data.object.object.update_matrix_from_shape(shape);
-
-        this->loop_->defer([this, data = std::move(data)]() {
-            std::stringstream message_stream;
-            msgpack::pack(message_stream, data);
-            std::string msg = message_stream.str();
-            this->app_->publish("all", msg, uWS::OpCode::BINARY, false);
-            (*this->root_)[data.path]->value().object = std::move(msg);
-        });
+        return data;
     }
 
-    void set_transform(std::string_view path, const MatrixView<const double>& matrix)
+    /**
+     * Pack the set_object command of a shape. The geometry and the material are interned, hence
+     * the objects having the same geometry (material) share its uuid and its packed definition.
+     * @return the absolute path of the object and the packed message.
+     */
+    template <typename T>
+    std::pair<std::string, details::ObjectMessage>
+    make_object_message(std::string_view path, const T& shape, const Material& material)
     {
-        details::TransformData data{.path = this->absolute_path(path)};
+        static_assert(std::is_base_of_v<::MeshcatCpp::Shape, T>, "Invalid shape type");
+
+        using Geometry = typename details::traits<T>::trampoline;
+        auto geometry = this->geometries_.intern(Geometry(shape));
+        auto material_definition = this->materials_.intern(details::MaterialTrampoline(material));
+
+        details::MeshData object;
+        object.geometry = geometry->uuid;
+        object.material = material_definition->uuid;
+        object.update_type_from_shape(shape);
+        object.update_matrix_from_shape(shape);
+
+        std::string absolute_path = this->absolute_path(path);
+        auto message = details::pack_object_message(absolute_path,
+                                                    std::move(geometry),
+                                                    std::move(material_definition),
+                                                    object);
+        return {std::move(absolute_path), std::move(message)};
+    }
 
-        auto matrix_view = data.transform();
-        matrix_view = matrix;
+    template <typename T>
+    void set_object(std::string_view path, const T& shape, const Material& material)
+    {
+        this->set_object_message(this->make_object_message(path, shape, material));
+    }
 
-        this->loop_->defer([this, data = std::move(data)]() {
-            std::stringstream message_stream;
-            msgpack::pack(message_stream, data);
-            std::string msg = message_stream.str();
-            this->app_->publish("all", msg, uWS::OpCode::BINARY, false);
-            (*this->root_)[data.path]->value().transform = std::move(msg);
+    void set_object_message(std::pair<std::string, details::ObjectMessage>&& message)
+    {
+        this->enqueue_task([this, message = std::move(message)]() mutable {
+            this->discard_object_updates(message.first);
+            this->publish_object(message.second.view(this->message_buffer_));
+            this->snapshot_.store_object(this->scene_node(message.first).object,
+                                         std::move(message.second));
         });
     }
 
-    std::thread websocket_thread_{};
-
-private:
-    static bool load_file(const std::string& filename, std::string& content)
+    /**
+     * Remove the point cloud updates of a path that are not published yet, since they are older
+     * than the object that replaces them. It must be called from the websocket_thread.
+     */
+    void discard_object_updates(const std::string& path)
     {
-        auto fs = ::cmrc::MeshcatCpp::get_filesystem();
-        if (!fs.exists(filename))
         {
-            std::cerr << "Unable to find " << filename << " in the embedded filesystem"
-                      << std::endl;
-            return false;
+            std::lock_guard<std::mutex> lock(this->pending_mutex_);
+            this->pending_.objects.erase(path);
         }
-        try
+        for (WebSocket* ws : this->sockets_)
         {
-            const auto file = fs.open(filename);
-            content = std::string(file.begin(), file.end());
-        } catch (const std::exception& e)
+            ws->getUserData()->pending_objects.erase(path);
+        }
+    }
+
+    /**
+     * Pack the set_object command of a shape whose buffers are owned by the caller (e.g.
+     * PointCloud and TriangleMesh). The message is packed in the calling thread and the buffers
+     * are copied only once, directly in the message.
+     * @param stable_uuids if true the uuids are derived from the path, so all the messages sent
+     * for the same path use the same uuids.
+     * @return the absolute path of the object and the packed message.
+     */
+    template <typename T>
+    std::pair<std::string, std::string> pack_set_object(std::string_view path,
+                                                        const T& shape,
+                                                        const Material& material,
+                                                        bool stable_uuids = false) const
+    {
+        auto data = this->make_set_object_data(path, shape, material);
+        if (stable_uuids)
         {
-            std::cerr << "Unable to open " << filename << " in the embedded filesystem"
-                      << std::endl;
-            std::cerr << "The following exception has been throw " << e.what() << std::endl;
+            using details::UUIDGenerator;
+            data.object.geometry->uuid = UUIDGenerator::from_name(data.path + "/geometry");
+            data.object.material->uuid = UUIDGenerator::from_name(data.path + "/material");
+            data.object.object.uuid = UUIDGenerator::from_name(data.path);
+            data.object.object.geometry = data.object.geometry->uuid;
+            data.object.object.material = data.object.material->uuid;
+        }
 
-            return false;
+        // The extra space is used for the metadata, the material and the uuids.
+        constexpr std::size_t metadata_size = 1024;
+        std::string message;
+        message.reserve(data.object.geometry->buffers_size() + metadata_size);
+        details::StringBuffer buffer{message};
+        msgpack::pack(buffer, data);
+
+        return {data.path, std::move(message)};
+    }
+
+    std::pair<std::string, std::string> pack_point_cloud(std::string_view path,
+                                                         const PointCloud& cloud,
+                                                         const Material& material,
+                                                         bool stable_uuids = false) const
+    {
+        Material points_material = material;
+        if (!cloud.has_colors())
+        {
+            points_material.vertexColors = false;
         }
+        return this->pack_set_object(path, cloud, points_material, stable_uuids);
+    }
 
-        return true;
+    void set_packed_object(std::pair<std::string, std::string>&& message)
+    {
+        details::ObjectMessage object;
+        object.head = details::SharedMessage(std::move(message.second));
+        this->set_object_message({std::move(message.first), std::move(object)});
     }
 
-    std::string absolute_path(std::string_view path) const
+    void set_object(std::string_view path, const PointCloud& cloud, const Material& material)
+    {
+        this->set_packed_object(this->pack_point_cloud(path, cloud, material));
+    }
+
+    void set_object(std::string_view path, const TriangleMesh& mesh, const Material& material)
+    {
+        this->set_packed_object(this->pack_set_object(path, mesh, material));
+    }
+
+    void update_point_cloud(std::string_view path,
+                            const PointCloud& cloud,
+                            const Material& material)
+    {
+        // meshcat has no message that replaces only the buffers of a geometry, hence every update
+        // is a whole set_object. Its uuids do not change, so the viewer sees the same object.
+        auto message = this->pack_point_cloud(path, cloud, material, true);
+
+        // The update goes through the queue, so it is ordered with the set_object and the delete
+        // of the same path. Then only the latest update of each path is kept until the conflated
+        // updates are published.
+        this->enqueue_task([this, message = std::move(message)]() mutable {
+            std::lock_guard<std::mutex> lock(this->pending_mutex_);
+            this->pending_.objects[message.first]
+                = details::SharedMessage(std::move(message.second));
+        });
+    }
+
+    void set_animation(const Animation& animation, bool play, unsigned int repetitions)
     {
-        assert(this->root_ != nullptr);
+        details::SetAnimationData data{animation, {}, play, repetitions};
+        data.paths.reserve(animation.clips().size());
+        for (const auto& [path, clip] : animation.clips())
+        {
+            // The paths of the clips are already absolute.
+            data.paths.push_back(path);
+        }
+
+        // The keyframes are packed in the calling thread, the extra space is used for the
+        // metadata and the paths.
+        constexpr std::size_t metadata_size = 256;
+        std::string packed;
+        packed.reserve(data.buffers_size() + metadata_size * (data.paths.size() + 1));
+        details::StringBuffer buffer{packed};
+        msgpack::pack(buffer, data);
+
+        this->enqueue_task([this, message = details::SharedMessage(std::move(packed))]() {
+            // set_animation messages are never dropped, as the set_object ones.
+            this->publish_object(message);
+            this->snapshot_.store_animation(message);
+        });
+    }
+
+    void delete_object(std::string_view path)
+    {
+        details::DeleteData data{.path = this->absolute_path(path)};
 
-        while (!path.empty() && path.find_last_of(this->root_->string_separator) == path.size() - 1)
+        if (this->conflates_updates())
         {
-            path.remove_prefix(this->root_->string_separator.size());
+            // The updates set before the deletion must not recreate the deleted nodes.
+            std::lock_guard<std::mutex> lock(this->pending_mutex_);
+            this->pending_.erase_subtree(data.path);
         }
 
-        if (path.empty())
+        std::string message;
+        pack_to_string(data, message);
+        this->enqueue_task([this, path = std::move(data.path), message = std::move(message)]() {
+            // The point cloud updates are stored by the websocket_thread, hence the ones queued
+            // before the deletion are removed here.
+            {
+                std::lock_guard<std::mutex> lock(this->pending_mutex_);
+                details::erase_subtree(this->pending_.objects, path);
+            }
+            this->publish_delete(path, message);
+            this->remove_subtree(path);
+        });
+    }
+
+    /**
+     * Remove a subtree from the scene tree and its messages from the snapshot. It must be called
+     * from the websocket_thread.
+     */
+    void remove_subtree(std::string_view path)
+    {
+        const Tree::Index node = this->tree_.find(path);
+        if (node == Tree::npos)
         {
-            return this->prefix_;
+            return;
         }
 
-        if (path.find_first_of(this->root_->string_separator) == 0)
+        this->tree_.erase(node, [this](Node& removed) {
+            this->snapshot_.erase_object(removed.object);
+            this->snapshot_.erase_transform(removed.transform);
+            for (auto& [name, slot] : removed.properties)
+            {
+                this->snapshot_.erase_property(slot);
+                this->property_names_.release(name);
+            }
+        });
+    }
+
+    void replay(const std::string& recording, double speed)
+    {
+        if (speed <= 0)
         {
-            return std::string(path);
+            throw std::runtime_error("The replay speed must be positive.");
         }
 
-        return this->prefix_ + this->root_->string_separator + std::string(path);
+        auto reader = std::make_unique<details::RecordingReader>(recording);
+        this->enqueue_task([this, reader = std::move(reader), speed]() mutable {
+            this->replay_ = std::move(reader);
+            this->replay_speed_ = speed;
+            this->seek_replay(0);
+        });
     }
 
-    void set_app_promise(uWS::App* app, uWS::Loop* loop, int port, us_listen_socket_t* socket)
+    void seek(double time)
     {
-        this->app_promise_.set_value(std::make_tuple(app, loop, port, socket));
+        const auto nanoseconds = static_cast<std::uint64_t>(std::max(0.0, time) * 1e9);
+        this->enqueue_task([this, nanoseconds]() {
+            if (this->replay_ != nullptr)
+            {
+                this->seek_replay(nanoseconds);
+            }
+        });
     }
 
-    void send_tree(WebSocket* ws, std::shared_ptr<details::TreeNode<Node>> node)
+    void export_static_html(const std::string& path)
     {
-        if (node == nullptr)
+        // The websocket_thread cannot wait for itself, hence the page is written immediately. The
+        // updates may be conflated by the caller (e.g. a message_sink called while flushing them),
+        // so the ones that are not published yet are not part of the exported scene.
+        if (this->on_websocket_thread())
         {
+            this->write_static_html(path);
             return;
         }
 
-        node->value().send(ws);
-        for (const auto& [name, child] : node->children())
-        {
-            assert(child != nullptr);
-            send_tree(ws, child);
-        }
+        // The snapshot is owned by the websocket_thread, the caller waits until the page is
+        // written so that the file can be used as soon as the function returns.
+        std::promise<void> exported;
+        auto future = exported.get_future();
+        this->enqueue_task([this, &path, &exported]() {
+            try
+            {
+                // The updates set before the call are part of the exported scene.
+                if (this->conflates_updates())
+                {
+                    this->flush_pending();
+                }
+
+                this->write_static_html(path);
+                exported.set_value();
+            } catch (...)
+            {
+                exported.set_exception(std::current_exception());
+            }
+        });
+        future.get();
     }
 
-    std::string index_html_;
-    std::string main_min_js_;
-    std::string favicon_;
+    /**
+     * Write the scene stored in the snapshot to a html page. It must be called from the
+     * websocket_thread. A local buffer is used since message_buffer_ may hold the message that is
+     * being published.
+     */
+    void write_static_html(const std::string& path)
+    {
+        details::StaticHtmlWriter writer(path, this->index_html_, this->main_min_js_);
+        details::SnapshotCursor cursor;
+        msgpack::sbuffer buffer;
+        this->snapshot_.resume(cursor, buffer, [&](std::string_view msg) {
+            writer.add_message(msg);
+            return true;
+        });
+        writer.finish();
+    }
 
-    std::promise<std::tuple<uWS::App*, uWS::Loop*, int, us_listen_socket_t*>> app_promise_{};
-    std::future<std::tuple<uWS::App*, uWS::Loop*, int, us_listen_socket_t*>> app_future_{};
+    /**
+     * Rebuild the scene from the beginning of the recording up to a given time and send it again
+     * to all the clients. It must be called from the websocket_thread.
+     * @param time the time in nanoseconds since the beginning of the recording.
+     */
+    void seek_replay(std::uint64_t time)
+    {
+        this->remove_subtree("");
+        this->snapshot_.erase_animation();
+
+        const auto& records = this->replay_->records();
+        const std::size_t end = this->replay_->upper_bound(time);
+        for (std::size_t i = 0; i < end; i++)
+        {
+            this->apply_recorded_message(records[i].message, false);
+        }
+        this->replay_next_ = end;
+        this->replay_time_ = time;
+        this->replay_wall_time_ = std::chrono::steady_clock::now();
+
+        // The clients are cleared and they receive the new scene as the new clients do.
+        const details::DeleteData data{.path = this->prefix_};
+        this->replaying_ = true;
+        this->publish_delete(data.path, this->pack_message(data));
+        this->replaying_ = false;
+        for (WebSocket* ws : this->sockets_)
+        {
+            ws->getUserData()->snapshot_cursor = details::SnapshotCursor{};
+            this->syncing_sockets_.insert(ws);
+            this->send_snapshot(ws);
+        }
+
+        this->advance_replay();
+    }
+
+    /**
+     * Publish the recorded messages whose time has come and schedule the next call.
+     */
+    void advance_replay()
+    {
+        const auto& records = this->replay_->records();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - this->replay_wall_time_);
+        const auto now = this->replay_time_
+                         + static_cast<std::uint64_t>(elapsed.count() * this->replay_speed_);
+
+        this->replaying_ = true;
+        for (; this->replay_next_ < records.size() && records[this->replay_next_].time <= now;
+             this->replay_next_++)
+        {
+            this->apply_recorded_message(records[this->replay_next_].message, true);
+        }
+        this->replaying_ = false;
+
+        if (this->replay_next_ == records.size())
+        {
+            return;
+        }
+
+        if (this->replay_timer_ == nullptr)
+        {
+            // The timer stores a pointer to the Impl in its extension.
+            this->replay_timer_ = us_create_timer(reinterpret_cast<us_loop_t*>(uWS::Loop::get()),
+                                                  0,
+                                                  sizeof(Impl*));
+            *static_cast<Impl**>(us_timer_ext(this->replay_timer_)) = this;
+        }
+
+        const double delay_ns
+            = static_cast<double>(records[this->replay_next_].time - now) / this->replay_speed_;
+        const int delay_ms = std::max(1, static_cast<int>(std::ceil(delay_ns * 1e-6)));
+        us_timer_set(
+            this->replay_timer_,
+            [](us_timer_t* timer) {
+                Impl* impl = *static_cast<Impl**>(us_timer_ext(timer));
+                impl->advance_replay();
+            },
+            delay_ms,
+            0);
+    }
+
+    /**
+     * Apply a recorded message to the scene. The message is stored in the snapshot as it is, and
+     * the scene tree is updated from the type and the path read from the message.
+     * @param msg the recorded message.
+     * @param publish if true the message is also sent to the clients.
+     */
+    void apply_recorded_message(std::string_view msg, bool publish)
+    {
+        details::MessageHeader header;
+        if (!details::parse_message_header(msg, header))
+        {
+            return;
+        }
+
+        const std::string path(header.path);
+        if (header.type == "set_object")
+        {
+            // The recorded objects are never dropped, as the ones set by the user.
+            const details::SharedMessage message(msg);
+            if (publish)
+            {
+                this->publish_object(message);
+            }
+            this->snapshot_.store_object(this->scene_node(path).object, message);
+        } else if (header.type == "set_transform")
+        {
+            if (publish)
+            {
+                this->publish_transform(path, msg);
+            }
+            this->snapshot_.store_transform(this->scene_node(path).transform, msg);
+        } else if (header.type == "set_property")
+        {
+            if (publish)
+            {
+                this->publish_property(path, std::string(header.property), msg);
+            }
+            this->snapshot_.store_property(
+                this->property_slot(this->scene_node(path), header.property),
+                msg);
+        } else if (header.type == "delete")
+        {
+            if (publish)
+            {
+                this->publish_delete(path, msg);
+            }
+            this->remove_subtree(path);
+        } else if (header.type == "set_animation")
+        {
+            const details::SharedMessage message(msg);
+            if (publish)
+            {
+                this->publish_object(message);
+            }
+            this->snapshot_.store_animation(message);
+        }
+    }
+
+    template <typename Scalar>
+    void set_transform(std::shared_ptr<details::NodeHandleData> node,
+                       const MatrixView<const Scalar>& matrix)
+    {
+        details::TransformData data;
+        data.node = std::move(node);
+        data.set_transform(matrix);
+        this->set_transform(std::move(data));
+    }
+
+    void set_transform(std::shared_ptr<details::NodeHandleData> node,
+                       const std::array<double, 3>& position,
+                       const std::array<double, 4>& quaternion)
+    {
+        details::PoseBlock block;
+        for (std::size_t k = 0; k < quaternion.size(); k++)
+        {
+            block.quaternions[k][0] = quaternion[k];
+        }
+        block.compute_rotations(1);
+
+        details::TransformData data;
+        data.node = std::move(node);
+        block.fill_transform(0, position[0], position[1], position[2], data.matrix);
+        this->set_transform(std::move(data));
+    }
+
+    void set_transform(details::TransformData&& data)
+    {
+        if (this->conflates_updates())
+        {
+            std::lock_guard<std::mutex> lock(this->pending_mutex_);
+            this->conflate_transform(std::move(data));
+            this->notify_pending_updates();
+            return;
+        }
+
+        details::Command command;
+        command.type = details::Command::Type::Transform;
+        command.transform = std::move(data);
+        this->enqueue(command);
+    }
+
+    void set_transforms(const std::vector<std::shared_ptr<details::NodeHandleData>>& nodes,
+                        const std::vector<MatrixView<const double>>& matrices)
+    {
+        if (nodes.size() != matrices.size())
+        {
+            throw std::runtime_error("The number of nodes and matrices must be the same.");
+        }
+
+        std::vector<details::TransformData> data(nodes.size());
+        for (std::size_t i = 0; i < nodes.size(); i++)
+        {
+            data[i].node = nodes[i];
+            data[i].set_transform(matrices[i]);
+        }
+
+        this->publish_transforms(std::move(data));
+    }
+
+    void set_transforms(const std::vector<std::shared_ptr<details::NodeHandleData>>& nodes,
+                        const MatrixView<const double>& matrices)
+    {
+        constexpr MatrixView<const double>::index_type size = 4;
+        if (matrices.rows() != size
+            || matrices.cols() != size * static_cast<MatrixView<const double>::index_type>(
+                   nodes.size()))
+        {
+            throw std::runtime_error("The matrices must be a 4 x (4 * number of nodes) matrix.");
+        }
+
+        // If the matrices are stored by column each transform is contiguous, unless the view is a
+        // block of a larger matrix. In that case the columns are not adjacent and the elements
+        // are copied one by one.
+        const bool is_contiguous = matrices.storageOrder() == MatrixStorageOrdering::ColumnMajor
+                                   && (nodes.empty() || &matrices(0, 1) == matrices.data() + size);
+
+        std::vector<details::TransformData> data(nodes.size());
+        for (std::size_t i = 0; i < nodes.size(); i++)
+        {
+            data[i].node = nodes[i];
+            auto matrix_view = data[i].transform();
+            const auto offset = size * static_cast<MatrixView<const double>::index_type>(i);
+
+            if (is_contiguous)
+            {
+                matrix_view.copy_from(
+                    details::TransformView<const double>(matrices.data() + size * offset));
+                continue;
+            }
+
+            for (MatrixView<const double>::index_type row = 0; row < size; row++)
+            {
+                for (MatrixView<const double>::index_type col = 0; col < size; col++)
+                {
+                    matrix_view(row, col) = matrices(row, offset + col);
+                }
+            }
+        }
+
+        this->publish_transforms(std::move(data));
+    }
+
+    void set_transforms(const std::vector<std::shared_ptr<details::NodeHandleData>>& nodes,
+                        const MatrixView<const double>& positions,
+                        const MatrixView<const double>& quaternions)
+    {
+        const auto count = static_cast<MatrixView<const double>::index_type>(nodes.size());
+        if (positions.rows() != 3 || positions.cols() != count)
+        {
+            throw std::runtime_error("The positions must be a 3 x (number of nodes) matrix.");
+        }
+        if (quaternions.rows() != 4 || quaternions.cols() != count)
+        {
+            throw std::runtime_error("The quaternions must be a 4 x (number of nodes) matrix.");
+        }
+
+        // The rotation matrices are computed by blocks. If the quaternions are stored by row each
+        // component is a contiguous array and it is copied as it is in the block.
+        const bool is_row_major = quaternions.storageOrder() == MatrixStorageOrdering::RowMajor;
+        std::vector<details::TransformData> data(nodes.size());
+        details::PoseBlock block;
+        for (MatrixView<const double>::index_type start = 0; start < count;
+             start += details::PoseBlock::size)
+        {
+            const auto size = std::min<MatrixView<const double>::index_type>(
+                details::PoseBlock::size, count - start);
+            for (MatrixView<const double>::index_type k = 0; k < 4; k++)
+            {
+                auto& component = block.quaternions[k];
+                if (is_row_major)
+                {
+                    std::copy_n(&quaternions(k, start), size, component.begin());
+                    continue;
+                }
+                for (MatrixView<const double>::index_type j = 0; j < size; j++)
+                {
+                    component[j] = quaternions(k, start + j);
+                }
+            }
+            block.compute_rotations(size);
+
+            for (MatrixView<const double>::index_type j = 0; j < size; j++)
+            {
+                const auto i = start + j;
+                auto& transform = data[i];
+                transform.node = nodes[i];
+                block.fill_transform(
+                    j, positions(0, i), positions(1, i), positions(2, i), transform.matrix);
+            }
+        }
+
+        this->publish_transforms(std::move(data));
+    }
+
+    std::shared_ptr<details::ModelData> set_model(std::string_view path, const Model& model)
+    {
+        auto data = std::make_shared<details::ModelData>(model);
+        const auto& links = data->model.links();
+        data->links.reserve(links.size());
+        data->positions.assign(data->model.number_of_joints(), 0);
+
+        // The visual shapes never move with respect to their link, their transform is published
+        // once.
+        std::vector<details::TransformData> transforms;
+        const std::string root = this->absolute_path(path);
+        for (std::size_t i = 0; i < links.size(); i++)
+        {
+            const auto& link = links[i];
+            const std::string& parent
+                = link.parent == Model::npos ? root : data->links[link.parent]->path;
+            data->links.push_back(this->make_node_handle(parent + Tree::separator + link.name));
+
+            auto& link_transform = transforms.emplace_back();
+            link_transform.node = data->links.back();
+            data->model.link_transform(i, 0, link_transform.matrix);
+
+            for (std::size_t k = 0; k < link.visuals.size(); k++)
+            {
+                const auto& visual = link.visuals[k];
+                const std::string visual_path
+                    = data->links.back()->path + Tree::separator + "visual_" + std::to_string(k);
+                std::visit(
+                    [&](const auto& shape) {
+                        this->set_object(visual_path, shape, visual.material);
+                    },
+                    visual.geometry);
+
+                auto& visual_transform = transforms.emplace_back();
+                visual_transform.node = this->make_node_handle(visual_path);
+                visual_transform.matrix = visual.origin;
+            }
+        }
+
+        this->publish_transforms(std::move(transforms));
+        return data;
+    }
+
+    void set_joint_positions(details::ModelData& data, const MatrixView<const double>& positions)
+    {
+        const auto joints = static_cast<MatrixView<const double>::index_type>(
+            data.model.number_of_joints());
+        if (positions.rows() != joints || positions.cols() != 1)
+        {
+            throw std::runtime_error("The positions must be a (number of joints) x 1 matrix.");
+        }
+
+        // Only the links whose joint moved are published, the browser composes the transforms of
+        // the nested links. The lock is held while the transforms are published, otherwise two
+        // callers could publish them in the opposite order of the positions they stored.
+        std::lock_guard<std::mutex> lock(data.mutex);
+        std::vector<details::TransformData> transforms;
+        const auto& links = data.model.links();
+        for (std::size_t i = 0; i < links.size(); i++)
+        {
+            const std::size_t joint = links[i].joint_index;
+            if (joint == Model::npos)
+            {
+                continue;
+            }
+
+            const double position
+                = positions(static_cast<MatrixView<const double>::index_type>(joint), 0);
+            if (position == data.positions[joint])
+            {
+                continue;
+            }
+
+            auto& transform = transforms.emplace_back();
+            transform.node = data.links[i];
+            data.model.link_transform(i, position, transform.matrix);
+            data.positions[joint] = position;
+        }
+
+        this->publish_transforms(std::move(transforms));
+    }
+
+    std::thread websocket_thread_{};
+
+private:
+    static bool load_file(const std::string& filename, std::string& content)
+    {
+        auto fs = ::cmrc::MeshcatCpp::get_filesystem();
+        if (!fs.exists(filename))
+        {
+            std::cerr << "Unable to find " << filename << " in the embedded filesystem"
+                      << std::endl;
+            return false;
+        }
+        try
+        {
+            const auto file = fs.open(filename);
+            content = std::string(file.begin(), file.end());
+        } catch (const std::exception& e)
+        {
+            std::cerr << "Unable to open " << filename << " in the embedded filesystem"
+                      << std::endl;
+            std::cerr << "The following exception has been throw " << e.what() << std::endl;
+
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Get the absolute path of a node. The paths are compared as strings by the pending updates,
+     * hence they have a single form: a leading separator and no empty segment (e.g.
+     * "/meshcat/box"). A relative path is appended to prefix_.
+     */
+    std::string absolute_path(std::string_view path) const
+    {
+        return details::absolute_path(path, this->prefix_);
+    }
+
+    /**
+     * Pack a message in the buffer owned by the websocket thread. The buffer keeps its capacity
+     * across the calls, so once it is warmed up no allocation is performed.
+     * @return a view of the packed message. The view is valid until the next call.
+     */
+    template <typename T> std::string_view pack_message(const T& data)
+    {
+        this->message_buffer_.clear();
+        msgpack::pack(this->message_buffer_, data);
+        return std::string_view(this->message_buffer_.data(), this->message_buffer_.size());
+    }
+
+    /**
+     * Store a message in a string. The memory already owned by the string is reused.
+     */
+    static void store_message(std::string& slot, std::string_view msg)
+    {
+        slot.assign(msg.data(), msg.size());
+    }
+
+    Node& resolve(details::NodeHandleData& node)
+    {
+        // The node is resolved again if it has been deleted.
+        if (node.node == Tree::npos || !this->tree_.contains(node.node, node.generation))
+        {
+            node.node = this->tree_[node.path];
+            node.generation = this->tree_.generation(node.node);
+        }
+        return this->tree_.value(node.node);
+    }
+
+    Node& scene_node(std::string_view path)
+    {
+        return this->tree_.value(this->tree_[path]);
+    }
+
+    /**
+     * Get the slot of a property of a node in the scene snapshot. The properties of a node are
+     * few, so they are searched linearly.
+     */
+    std::size_t& property_slot(Node& node, std::string_view property)
+    {
+        const auto name = this->property_names_.find(property);
+        for (auto& [id, slot] : node.properties)
+        {
+            if (id == name)
+            {
+                return slot;
+            }
+        }
+
+        // Each node holds a reference to the names of its properties.
+        return node.properties
+            .emplace_back(this->property_names_.intern(property), details::SceneSnapshot::npos)
+            .second;
+    }
+
+    /**
+     * Pack a message in a buffer owned by the calling thread and copy it in a string.
+     */
+    template <typename T> static void pack_to_string(const T& data, std::string& message)
+    {
+        thread_local msgpack::sbuffer buffer(thread_buffer_initial_size);
+        buffer.clear();
+        msgpack::pack(buffer, data);
+        message.assign(buffer.data(), buffer.size());
+    }
+
+    void publish_transforms(std::vector<details::TransformData>&& data)
+    {
+        if (data.empty())
+        {
+            return;
+        }
+
+        if (this->conflates_updates())
+        {
+            std::lock_guard<std::mutex> lock(this->pending_mutex_);
+            for (auto& transform : data)
+            {
+                this->conflate_transform(std::move(transform));
+            }
+            this->notify_pending_updates();
+            return;
+        }
+
+        // The transforms are pushed one by one, the websocket_thread packs the consecutive
+        // transforms in a single pass.
+        details::Command command;
+        command.type = details::Command::Type::Transform;
+        for (auto& transform : data)
+        {
+            command.transform = std::move(transform);
+            this->enqueue(command);
+        }
+    }
+
+    void enqueue_task(uWS::MoveOnlyFunction<void()>&& task)
+    {
+        details::Command command;
+        command.task = std::move(task);
+        this->enqueue(command);
+    }
+
+    bool on_websocket_thread() const
+    {
+        return std::this_thread::get_id() == this->websocket_thread_id_;
+    }
+
+    /**
+     * Push a command in the queue and wake up the websocket_thread. If the queue is full the
+     * caller waits until the websocket_thread pops some commands.
+     * @note The websocket_thread cannot wait for itself (e.g. when a message_sink or a task calls
+     * the public API). Its commands are stored in an unbounded queue when the ring is full, and
+     * as long as that queue is not empty to preserve their order.
+     */
+    void enqueue(details::Command& command)
+    {
+        if (this->on_websocket_thread())
+        {
+            if (!this->overflow_commands_.empty() || !this->commands_.push(command))
+            {
+                this->overflow_commands_.push_back(std::move(command));
+            }
+            this->schedule_drain();
+            return;
+        }
+
+        while (!this->commands_.push(command))
+        {
+            this->schedule_drain();
+            std::this_thread::yield();
+        }
+        this->schedule_drain();
+    }
+
+    /**
+     * Wake up the websocket_thread if a drain is not already scheduled. Hence, the
+     * websocket_thread is woken up once for all the commands pushed before the drain starts.
+     */
+    void schedule_drain()
+    {
+        if (!this->drain_scheduled_.exchange(true, std::memory_order_acq_rel))
+        {
+            this->loop_->defer([this]() { this->drain(); });
+        }
+    }
+
+    /**
+     * Execute all the commands in the queue and publish the conflated updates. It must be called
+     * from the websocket_thread.
+     */
+    void drain()
+    {
+        // The flag is reset before popping, so a command pushed after the last pop always
+        // schedules a new drain.
+        this->drain_scheduled_.exchange(false, std::memory_order_acq_rel);
+
+        details::Command command;
+        while (this->pop_command(command))
+        {
+            if (command.type == details::Command::Type::Transform)
+            {
+                this->drained_transforms_.push_back(std::move(command.transform));
+                continue;
+            }
+
+            // The transforms popped before the task are published first to preserve the order.
+            this->publish_drained_transforms();
+            command.task();
+            command.task = nullptr;
+        }
+        this->publish_drained_transforms();
+
+        // If the publish rate is limited the conflated updates are published by the timer.
+        if (this->params_.max_publish_rate <= 0)
+        {
+            this->flush_pending();
+        }
+    }
+
+    /**
+     * Pop the next command. The commands pushed in the ring are executed before the ones stored in
+     * the overflow queue by the websocket_thread.
+     */
+    bool pop_command(details::Command& command)
+    {
+        if (this->commands_.pop(command))
+        {
+            return true;
+        }
+
+        if (this->overflow_commands_.empty())
+        {
+            return false;
+        }
+
+        command = std::move(this->overflow_commands_.front());
+        this->overflow_commands_.pop_front();
+        return true;
+    }
+
+    bool conflates_updates() const
+    {
+        return this->params_.conflate_updates || this->params_.max_publish_rate > 0;
+    }
+
+    /**
+     * Notify the websocket_thread that some conflated updates are pending. If the publish rate is
+     * limited, the updates are published by the timer, hence the websocket_thread is not woken up.
+     */
+    void notify_pending_updates()
+    {
+        if (this->params_.max_publish_rate <= 0)
+        {
+            this->schedule_drain();
+        }
+    }
+
+    /**
+     * Start the timer that publishes the updates conflated during a frame. The timer is started
+     * only if the publish rate is limited.
+     */
+    void start_publish_timer(uWS::Loop* loop)
+    {
+        if (this->params_.max_publish_rate <= 0)
+        {
+            return;
+        }
+
+        const int period_ms
+            = std::max(1, static_cast<int>(std::lround(1000.0 / this->params_.max_publish_rate)));
+
+        // The timer stores a pointer to the Impl in its extension.
+        this->publish_timer_
+            = us_create_timer(reinterpret_cast<us_loop_t*>(loop), 0, sizeof(Impl*));
+        *static_cast<Impl**>(us_timer_ext(this->publish_timer_)) = this;
+        us_timer_set(
+            this->publish_timer_,
+            [](us_timer_t* timer) {
+                Impl* impl = *static_cast<Impl**>(us_timer_ext(timer));
+                // The queued commands (e.g. a delete) are executed before the updates of the
+                // frame, so the updates are applied in the order they are set.
+                impl->drain();
+                impl->flush_pending();
+            },
+            period_ms,
+            period_ms);
+    }
+
+    void publish_drained_transforms()
+    {
+        this->publish_transform_batch(this->drained_transforms_.begin(),
+                                      this->drained_transforms_.end());
+        this->drained_transforms_.clear();
+    }
+
+    static const details::TransformData& get_transform(const details::TransformData& data)
+    {
+        return data;
+    }
+
+    static const details::TransformData&
+    get_transform(const std::pair<const std::string, details::TransformData>& data)
+    {
+        return data.second;
+    }
+
+    /**
+     * Publish a batch of transforms. It must be called from the websocket_thread.
+     */
+    template <typename Iterator> void publish_transform_batch(Iterator begin, Iterator end)
+    {
+        // All the messages are packed in a single buffer, each message is then published using
+        // a view of the buffer.
+        this->message_buffer_.clear();
+        this->message_offsets_.clear();
+        this->message_offsets_.push_back(0);
+        for (auto it = begin; it != end; ++it)
+        {
+            get_transform(*it).pack(this->message_buffer_, this->params_.float32_transforms);
+            this->message_offsets_.push_back(this->message_buffer_.size());
+        }
+
+        std::size_t i = 0;
+        for (auto it = begin; it != end; ++it, ++i)
+        {
+            const auto& offsets = this->message_offsets_;
+            const std::string_view msg(this->message_buffer_.data() + offsets[i],
+                                       offsets[i + 1] - offsets[i]);
+            auto& node = *get_transform(*it).node;
+            this->publish_transform(node.path, msg);
+            this->snapshot_.store_transform(this->resolve(node).transform, msg);
+        }
+    }
+
+    /**
+     * Replace the pending transform associated to the path of data. pending_mutex_ must be locked
+     * by the caller.
+     */
+    void conflate_transform(details::TransformData&& data)
+    {
+        auto& pending = this->pending_.transforms[data.node->path];
+        pending = std::move(data);
+    }
+
+    /**
+     * Publish the pending updates. It must be called from the websocket_thread.
+     */
+    void flush_pending()
+    {
+        {
+            // The updates set while the pending ones are published will be published by the
+            // next drain.
+            std::lock_guard<std::mutex> lock(this->pending_mutex_);
+            std::swap(this->pending_, this->flushing_);
+        }
+
+        this->publish_transform_batch(this->flushing_.transforms.begin(),
+                                      this->flushing_.transforms.end());
+
+        for (const auto& [key, property] : this->flushing_.properties)
+        {
+            this->publish_property(property.node->path, property.property, property.message);
+            this->snapshot_.store_property(
+                this->property_slot(this->resolve(*property.node), property.property),
+                property.message);
+        }
+
+        for (const auto& [path, message] : this->flushing_.objects)
+        {
+            this->publish_object_update(path, message);
+            this->snapshot_.store_object(this->scene_node(path).object, message);
+        }
+
+        this->flushing_.clear();
+    }
+
+    void set_app_promise(uWS::App* app, uWS::Loop* loop, int port, us_listen_socket_t* socket)
+    {
+        this->app_promise_.set_value(std::make_tuple(app, loop, port, socket));
+    }
+
+    /**
+     * Append a published message to the recording and pass it to the message sink, if enabled.
+     */
+    void record(std::string_view msg)
+    {
+        // The replayed messages are already in a recording, hence they are not recorded again.
+        if (this->recorder_ != nullptr && !this->replaying_)
+        {
+            // The function is called by the websocket_thread, an exception would stop the event
+            // loop. The recording is stopped instead and the scene is still published.
+            try
+            {
+                this->recorder_->append(msg);
+            } catch (const std::exception& e)
+            {
+                std::cerr << "Unable to append the message to the recording, the recording is "
+                             "stopped. The following exception has been thrown "
+                          << e.what() << std::endl;
+                this->recorder_.reset();
+            }
+        }
+        if (this->params_.message_sink)
+        {
+            this->params_.message_sink(msg);
+        }
+    }
+
+    void publish_object(std::string_view msg)
+    {
+        this->record(msg);
+        // set_object messages are never dropped.
+        for (WebSocket* ws : this->sockets_)
+        {
+            ws->send(msg, uWS::OpCode::BINARY, false);
+        }
+    }
+
+    void publish_delete(const std::string& path, std::string_view msg)
+    {
+        this->record(msg);
+        for (WebSocket* ws : this->sockets_)
+        {
+            // The messages kept aside for the deleted nodes would recreate them.
+            auto* data = ws->getUserData();
+            details::erase_subtree(data->pending_transforms, path);
+            details::erase_subtree(data->pending_properties, path);
+            details::erase_subtree(data->pending_objects, path);
+
+            // delete messages are never dropped.
+            ws->send(msg, uWS::OpCode::BINARY, false);
+        }
+    }
+
+    void publish_object_update(const std::string& path, const details::SharedMessage& msg)
+    {
+        this->record(msg);
+        for (WebSocket* ws : this->sockets_)
+        {
+            this->send_object_update(ws, path, msg);
+        }
+    }
+
+    void publish_transform(const std::string& path, std::string_view msg)
+    {
+        this->record(msg);
+        for (WebSocket* ws : this->sockets_)
+        {
+            this->send_transform(ws, path, msg);
+        }
+    }
+
+    void
+    publish_property(const std::string& path, const std::string& property, std::string_view msg)
+    {
+        this->record(msg);
+        for (WebSocket* ws : this->sockets_)
+        {
+            this->send_property(ws, path, property, msg);
+        }
+    }
+
+    /**
+     * Check if the messages that can be replaced by a newer one should be kept aside instead of
+     * being sent to the socket.
+     */
+    bool is_congested(WebSocket* ws) const
+    {
+        if (this->params_.max_socket_backpressure == 0)
+        {
+            return false;
+        }
+
+        // If some messages are already kept aside, the new ones must wait as well, otherwise an
+        // older message may be sent after a newer one.
+        return ws->getUserData()->has_pending_messages()
+               || ws->getBufferedAmount() > this->params_.max_socket_backpressure;
+    }
+
+    void send_transform(WebSocket* ws, const std::string& path, std::string_view msg)
+    {
+        if (this->is_congested(ws))
+        {
+            store_message(ws->getUserData()->pending_transforms[path], msg);
+            return;
+        }
+        ws->send(msg, uWS::OpCode::BINARY, false);
+    }
+
+    void
+    send_object_update(WebSocket* ws, const std::string& path, const details::SharedMessage& msg)
+    {
+        if (this->is_congested(ws))
+        {
+            // The congested sockets share the message instead of copying it.
+            ws->getUserData()->pending_objects[path] = msg;
+            return;
+        }
+        ws->send(msg, uWS::OpCode::BINARY, false);
+    }
+
+    void send_property(WebSocket* ws,
+                       const std::string& path,
+                       const std::string& property,
+                       std::string_view msg)
+    {
+        if (this->is_congested(ws))
+        {
+            store_message(ws->getUserData()->pending_properties[{path, property}], msg);
+            return;
+        }
+        ws->send(msg, uWS::OpCode::BINARY, false);
+    }
+
+    /**
+     * Send the messages kept aside while the socket was congested. The messages are sent until
+     * the buffered amount exceeds the threshold again.
+     */
+    void send_pending_messages(WebSocket* ws)
+    {
+        auto* data = ws->getUserData();
+        const auto is_full = [this, ws]() {
+            return ws->getBufferedAmount() > this->params_.max_socket_backpressure;
+        };
+
+        for (auto it = data->pending_objects.begin();
+             it != data->pending_objects.end() && !is_full();)
+        {
+            ws->send(it->second, uWS::OpCode::BINARY, false);
+            it = data->pending_objects.erase(it);
+        }
+
+        for (auto it = data->pending_transforms.begin();
+             it != data->pending_transforms.end() && !is_full();)
+        {
+            ws->send(it->second, uWS::OpCode::BINARY, false);
+            it = data->pending_transforms.erase(it);
+        }
+
+        for (auto it = data->pending_properties.begin();
+             it != data->pending_properties.end() && !is_full();)
+        {
+            ws->send(it->second, uWS::OpCode::BINARY, false);
+            it = data->pending_properties.erase(it);
+        }
+    }
+
+    /**
+     * Send the next slice of the scene to a new client. The slice ends when the socket buffers
+     * snapshot_slice_size bytes. If the socket is congested the next slice is sent by the drain
+     * callback, otherwise it is deferred so that the loop can serve the other clients in between.
+     */
+    void send_snapshot(WebSocket* ws)
+    {
+        if (this->syncing_sockets_.find(ws) == this->syncing_sockets_.end())
+        {
+            return;
+        }
+
+        const std::size_t slice_size = this->params_.snapshot_slice_size;
+        const auto has_room = [ws, slice_size]() {
+            return slice_size == 0 || ws->getBufferedAmount() < slice_size;
+        };
+        if (!has_room())
+        {
+            return;
+        }
+
+        auto& cursor = ws->getUserData()->snapshot_cursor;
+        bool done = false;
+        ws->cork([&]() {
+            std::size_t sent = 0;
+            done = this->snapshot_.resume(cursor, this->message_buffer_, [&](std::string_view msg) {
+                ws->send(msg, uWS::OpCode::BINARY, false);
+                sent += msg.size();
+                return slice_size == 0 || (sent < slice_size && has_room());
+            });
+        });
+
+        if (done)
+        {
+            this->syncing_sockets_.erase(ws);
+        } else if (has_room())
+        {
+            uWS::Loop::get()->defer([this, ws]() { this->send_snapshot(ws); });
+        }
+    }
+
+    std::string index_html_;
+    std::string main_min_js_;
+    std::string favicon_;
+
+    std::promise<std::tuple<uWS::App*, uWS::Loop*, int, us_listen_socket_t*>> app_promise_{};
+    std::future<std::tuple<uWS::App*, uWS::Loop*, int, us_listen_socket_t*>> app_future_{};
 
     // As explained in
     // https://github.com/uNetworking/uWebSockets/blob/d94bf2cd43bed5e0de396a8412f156e15c141e98/misc/READMORE.md#threading
     // Only loop_->defer() should be called from outside the websocket_thread.
     uWS::Loop* loop_{nullptr};
 
+    const MeshcatParams params_;
+
+    // Commands pushed by the caller threads and executed by the websocket_thread.
+    details::CommandQueue<details::Command> commands_;
+    std::atomic<bool> drain_scheduled_{false};
+    // Set by the websocket_thread before the app promise is fulfilled.
+    std::thread::id websocket_thread_id_;
+
+    // Updates conflated by path. pending_ is filled by the caller threads, while flushing_ is
+    // used by the websocket_thread to publish them.
+    std::mutex pending_mutex_;
+    details::PendingUpdates pending_;
+    details::PendingUpdates flushing_;
+
+    // Geometries and materials shared by the objects. They can be used by any thread.
+    details::DefinitionCache geometries_{"geometries"};
+    details::DefinitionCache materials_{"materials"};
+
     // The remaining variables should only be accessed from the websocket_thread.
     uWS::App* app_{nullptr};
     us_listen_socket_t* listen_socket_{nullptr};
     int port_{-1};
 
-    std::shared_ptr<details::TreeNode<Node>> root_;
-    std::string prefix_{"meshcat"};
-    };
+    Tree tree_;
+    details::StringInterner property_names_;
+    details::SceneSnapshot snapshot_;
+    std::string prefix_{details::scene_prefix};
+    std::unordered_set<WebSocket*> sockets_;
+    // Sockets that did not receive the whole scene yet.
+    std::unordered_set<WebSocket*> syncing_sockets_;
+    us_timer_t* publish_timer_{nullptr};
+
+    // Recording of the published messages and recording being replayed.
+    std::unique_ptr<details::RecordingWriter> recorder_;
+    std::unique_ptr<details::RecordingReader> replay_;
+    std::size_t replay_next_{0};
+    double replay_speed_{1};
+    std::uint64_t replay_time_{0};
+    std::chrono::steady_clock::time_point replay_wall_time_;
+    us_timer_t* replay_timer_{nullptr};
+    // True while the recorded messages are published.
+    bool replaying_{false};
+    us_timer_t* keep_alive_timer_{nullptr};
+
+    // Handles of the nodes updated by path, shared by all the calls using the same path.
+    static constexpr std::size_t handles_min_sweep_size = 1024;
+    mutable std::mutex handles_mutex_;
+    mutable std::unordered_map<std::string, std::shared_ptr<details::NodeHandleData>> handles_;
+    mutable std::size_t handles_sweep_size_{handles_min_sweep_size};
+
+    // Buffers used to pack the messages. They are reused across the calls.
+    static constexpr std::size_t thread_buffer_initial_size = 256;
+    static constexpr std::size_t message_buffer_initial_size = 64 * 1024;
+    msgpack::sbuffer message_buffer_{message_buffer_initial_size};
+    std::vector<std::size_t> message_offsets_;
+    std::vector<details::TransformData> drained_transforms_;
+    // Commands enqueued by the websocket_thread while the ring was full.
+    std::deque<details::Command> overflow_commands_;
+};
 
 Meshcat::Meshcat()
+    : Meshcat(MeshcatParams{})
+{
+}
+
+Meshcat::Meshcat(const MeshcatParams& params)
 {
     // A std::promise is made in the WebSocketPublisher.
-    this->pimpl_ = std::make_unique<Impl>();
+    this->pimpl_ = std::make_unique<Impl>(params);
     this->pimpl_->websocket_thread_
         = std::thread(&Meshcat::Impl::websocket_main, this->pimpl_.get());
 
@@ -391,9 +1997,69 @@ void Meshcat::join()
     this->pimpl_->websocket_thread_.join();
 }
 
+NodeHandle::NodeHandle(std::shared_ptr<details::NodeHandleData> data)
+    : data_(std::move(data))
+{
+}
+
+bool NodeHandle::is_valid() const
+{
+    return this->data_ != nullptr;
+}
+
+const std::string& NodeHandle::path() const
+{
+    static const std::string empty_path;
+    return this->is_valid() ? this->data_->path : empty_path;
+}
+
+const std::shared_ptr<details::NodeHandleData>& Meshcat::handle_data(const NodeHandle& node)
+{
+    if (!node.is_valid())
+    {
+        throw std::runtime_error("The node handle is not valid.");
+    }
+    return node.data_;
+}
+
+ModelHandle::ModelHandle(std::shared_ptr<details::ModelData> data)
+    : data_(std::move(data))
+{
+}
+
+bool ModelHandle::is_valid() const
+{
+    return this->data_ != nullptr;
+}
+
+ModelHandle Meshcat::set_model(std::string_view path, const Model& model)
+{
+    return ModelHandle(this->pimpl_->set_model(path, model));
+}
+
+void Meshcat::set_joint_positions(const ModelHandle& model,
+                                  const MatrixView<const double>& positions)
+{
+    if (!model.is_valid())
+    {
+        throw std::runtime_error("The model handle is not valid.");
+    }
+    this->pimpl_->set_joint_positions(*model.data_, positions);
+}
+
+NodeHandle Meshcat::node(std::string_view path)
+{
+    return NodeHandle(this->pimpl_->node_handle(path));
+}
+
 void Meshcat::set_property(std::string_view path, const std::string& property, bool value)
 {
-    this->pimpl_->set_property(path, property, value);
+    this->pimpl_->set_property(this->pimpl_->node_handle(path), property, value);
+}
+
+void Meshcat::set_property(const NodeHandle& node, const std::string& property, bool value)
+{
+    this->pimpl_->set_property(handle_data(node), property, value);
 }
 
 void Meshcat::set_object(std::string_view path, const Sphere& sphere, const Material& material)
@@ -403,7 +2069,92 @@ void Meshcat::set_object(std::string_view path, const Sphere& sphere, const Mate
 
 void Meshcat::set_transform(std::string_view path, const MatrixView<const double>& matrix)
 {
-    this->pimpl_->set_transform(path, matrix);
+    this->pimpl_->set_transform(this->pimpl_->node_handle(path), matrix);
+}
+
+void Meshcat::set_transform(const NodeHandle& node, const MatrixView<const double>& matrix)
+{
+    this->pimpl_->set_transform(handle_data(node), matrix);
+}
+
+void Meshcat::set_transform(std::string_view path, const MatrixView<const float>& matrix)
+{
+    this->pimpl_->set_transform(this->pimpl_->node_handle(path), matrix);
+}
+
+void Meshcat::set_transform(const NodeHandle& node, const MatrixView<const float>& matrix)
+{
+    this->pimpl_->set_transform(handle_data(node), matrix);
+}
+
+void Meshcat::set_transform(std::string_view path,
+                            const std::array<double, 3>& position,
+                            const std::array<double, 4>& quaternion)
+{
+    this->pimpl_->set_transform(this->pimpl_->node_handle(path), position, quaternion);
+}
+
+void Meshcat::set_transform(const NodeHandle& node,
+                            const std::array<double, 3>& position,
+                            const std::array<double, 4>& quaternion)
+{
+    this->pimpl_->set_transform(handle_data(node), position, quaternion);
+}
+
+void Meshcat::set_transforms(const std::vector<std::string>& paths,
+                             const std::vector<MatrixView<const double>>& matrices)
+{
+    this->pimpl_->set_transforms(this->pimpl_->node_handles(paths), matrices);
+}
+
+void Meshcat::set_transforms(const std::vector<std::string>& paths,
+                             const MatrixView<const double>& matrices)
+{
+    this->pimpl_->set_transforms(this->pimpl_->node_handles(paths), matrices);
+}
+
+void Meshcat::set_transforms(const std::vector<NodeHandle>& nodes,
+                             const std::vector<MatrixView<const double>>& matrices)
+{
+    std::vector<std::shared_ptr<details::NodeHandleData>> data;
+    data.reserve(nodes.size());
+    for (const auto& node : nodes)
+    {
+        data.push_back(handle_data(node));
+    }
+    this->pimpl_->set_transforms(data, matrices);
+}
+
+void Meshcat::set_transforms(const std::vector<NodeHandle>& nodes,
+                             const MatrixView<const double>& matrices)
+{
+    std::vector<std::shared_ptr<details::NodeHandleData>> data;
+    data.reserve(nodes.size());
+    for (const auto& node : nodes)
+    {
+        data.push_back(handle_data(node));
+    }
+    this->pimpl_->set_transforms(data, matrices);
+}
+
+void Meshcat::set_transforms(const std::vector<std::string>& paths,
+                             const MatrixView<const double>& positions,
+                             const MatrixView<const double>& quaternions)
+{
+    this->pimpl_->set_transforms(this->pimpl_->node_handles(paths), positions, quaternions);
+}
+
+void Meshcat::set_transforms(const std::vector<NodeHandle>& nodes,
+                             const MatrixView<const double>& positions,
+                             const MatrixView<const double>& quaternions)
+{
+    std::vector<std::shared_ptr<details::NodeHandleData>> data;
+    data.reserve(nodes.size());
+    for (const auto& node : nodes)
+    {
+        data.push_back(handle_data(node));
+    }
+    this->pimpl_->set_transforms(data, positions, quaternions);
 }
 
 void Meshcat::set_object(std::string_view path, const Cylinder& cylinder, const Material& material)
@@ -428,4 +2179,53 @@ void Meshcat::set_object(std::string_view path, const Box& box, const Material&
     this->pimpl_->set_object(path, box, material);
 }
 
+void Meshcat::set_object(std::string_view path, const PointCloud& cloud, const Material& material)
+{
+    this->pimpl_->set_object(path, cloud, material);
+}
+
+void Meshcat::set_animation(const Animation& animation, bool play, unsigned int repetitions)
+{
+    this->pimpl_->set_animation(animation, play, repetitions);
+}
+
+void Meshcat::replay(const std::string& recording, double speed)
+{
+    this->pimpl_->replay(recording, speed);
+}
+
+void Meshcat::seek(double time)
+{
+    this->pimpl_->seek(time);
+}
+
+void Meshcat::export_static_html(const std::string& path)
+{
+    this->pimpl_->export_static_html(path);
+}
+
+void Meshcat::delete_object(std::string_view path)
+{
+    this->pimpl_->delete_object(path);
+}
+
+void Meshcat::delete_object(const NodeHandle& node)
+{
+    this->pimpl_->delete_object(handle_data(node)->path);
+}
+
+void Meshcat::set_object(std::string_view path,
+                         const TriangleMesh& mesh,
+                         const Material& material)
+{
+    this->pimpl_->set_object(path, mesh, material);
+}
+
+void Meshcat::update_point_cloud(std::string_view path,
+                                 const PointCloud& cloud,
+                                 const Material& material)
+{
+    this->pimpl_->update_point_cloud(path, cloud, material);
+}
+
 } // namespace MeshcatCpp
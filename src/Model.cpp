@@ -0,0 +1,186 @@
+/**
+ * @file Model.cpp
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#include <MeshcatCpp/Model.h>
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace MeshcatCpp;
+
+namespace
+{
+
+std::array<double, 16> to_array(const MatrixView<const double>& matrix)
+{
+    if (matrix.rows() != 4 || matrix.cols() != 4)
+    {
+        throw std::runtime_error("The transform must be a 4x4 matrix.");
+    }
+
+    std::array<double, 16> values;
+    const auto view
+        = make_fixed_matrix_view<4, 4, MatrixStorageOrdering::ColumnMajor>(values.data());
+    view.copy_from(matrix);
+    return values;
+}
+
+/**
+ * The links are published as the nodes of a path, hence their names must be valid path segments.
+ */
+void check_link_name(std::string_view name)
+{
+    if (name.empty())
+    {
+        throw std::runtime_error("The name of a link cannot be empty.");
+    }
+    if (name.find('/') != std::string_view::npos)
+    {
+        throw std::runtime_error("The name of the link " + std::string(name)
+                                 + " cannot contain '/'.");
+    }
+}
+
+} // namespace
+
+Model::Model(std::string_view root_link)
+{
+    check_link_name(root_link);
+    Link root{.name = std::string(root_link),
+              .parent = npos,
+              .joint_type = JointType::Fixed,
+              .joint_origin = {},
+              .joint_axis = {0, 0, 1},
+              .joint_index = npos,
+              .visuals = {}};
+    for (std::size_t i = 0; i < 4; i++)
+    {
+        root.joint_origin[5 * i] = 1;
+    }
+    this->links_.push_back(std::move(root));
+}
+
+void Model::add_link(std::string_view name,
+                     std::string_view parent,
+                     JointType type,
+                     const MatrixView<const double>& origin,
+                     const std::array<double, 3>& axis)
+{
+    check_link_name(name);
+    for (const auto& link : this->links_)
+    {
+        if (link.name == name)
+        {
+            throw std::runtime_error("The link " + std::string(name) + " already exists.");
+        }
+    }
+
+    Link link{.name = std::string(name),
+              .parent = this->find_link(parent),
+              .joint_type = type,
+              .joint_origin = to_array(origin),
+              .joint_axis = axis,
+              .joint_index = npos,
+              .visuals = {}};
+
+    if (type != JointType::Fixed)
+    {
+        const double norm = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        if (norm == 0)
+        {
+            throw std::runtime_error("The axis of the joint of " + link.name + " is zero.");
+        }
+        for (auto& value : link.joint_axis)
+        {
+            value /= norm;
+        }
+        link.joint_index = this->number_of_joints_++;
+    }
+
+    this->links_.push_back(std::move(link));
+}
+
+void Model::add_visual(std::string_view link,
+                       const Geometry& geometry,
+                       const MatrixView<const double>& origin,
+                       const Material& material)
+{
+    this->links_[this->find_link(link)].visuals.push_back(
+        Visual{.geometry = geometry, .origin = to_array(origin), .material = material});
+}
+
+void Model::link_transform(std::size_t link,
+                           double position,
+                           std::array<double, 16>& transform) const
+{
+    const Link& data = this->links_[link];
+    transform = data.joint_origin;
+    if (data.joint_type == JointType::Fixed || position == 0)
+    {
+        return;
+    }
+
+    const auto& origin = data.joint_origin;
+    const auto& [x, y, z] = data.joint_axis;
+    if (data.joint_type == JointType::Prismatic)
+    {
+        // The translation is expressed in the link frame, i.e. it is rotated by the origin.
+        for (std::size_t row = 0; row < 3; row++)
+        {
+            transform[12 + row] += position * (origin[row] * x + origin[4 + row] * y
+                                               + origin[8 + row] * z);
+        }
+        return;
+    }
+
+    // Rotation about the axis computed with the Rodrigues' formula. It is stored by column.
+    const double c = std::cos(position);
+    const double s = std::sin(position);
+    const double t = 1 - c;
+    const std::array<double, 9> rotation{t * x * x + c,
+                                         t * x * y + s * z,
+                                         t * x * z - s * y,
+                                         t * x * y - s * z,
+                                         t * y * y + c,
+                                         t * y * z + s * x,
+                                         t * x * z + s * y,
+                                         t * y * z - s * x,
+                                         t * z * z + c};
+
+    // Only the rotational part of the origin is multiplied by the rotation of the joint.
+    for (std::size_t col = 0; col < 3; col++)
+    {
+        for (std::size_t row = 0; row < 3; row++)
+        {
+            transform[4 * col + row] = origin[row] * rotation[3 * col]
+                                       + origin[4 + row] * rotation[3 * col + 1]
+                                       + origin[8 + row] * rotation[3 * col + 2];
+        }
+    }
+}
+
+std::size_t Model::number_of_joints() const
+{
+    return this->number_of_joints_;
+}
+
+const std::vector<Model::Link>& Model::links() const
+{
+    return this->links_;
+}
+
+std::size_t Model::find_link(std::string_view name) const
+{
+    for (std::size_t i = 0; i < this->links_.size(); i++)
+    {
+        if (this->links_[i].name == name)
+        {
+            return i;
+        }
+    }
+    throw std::runtime_error("The link " + std::string(name) + " does not exist.");
+}
@@ -9,9 +9,6 @@
 #include <MeshcatCpp/impl/UUIDGenerator.h>
 #include <MeshcatCpp/MatrixView.h>
 
-#include <filesystem>
-#include <fstream>
-
 using namespace MeshcatCpp::details;
 
 MaterialTrampoline::MaterialTrampoline(const ::MeshcatCpp::Material& material)
@@ -42,66 +39,24 @@ SphereTrampoline::SphereTrampoline(const ::MeshcatCpp::Sphere& sphere)
 {
 }
 
-void SphereTrampoline::msgpack_pack(msgpack::packer<std::stringstream>& o) const
-{
-    o.pack_map(5);
-    PACK_MAP_VAR_FROM_INNER_CLASS(o, sphere, type);
-    PACK_MAP_VAR(o, uuid);
-    PACK_MAP_VAR_WITH_NAME(o, radius, sphere.radius());
-    PACK_MAP_VAR(o, widthSegments);
-    PACK_MAP_VAR(o, heightSegments);
-}
-
 CylinderTrampoline::CylinderTrampoline(const ::MeshcatCpp::Cylinder& cylinder)
     : GeometryData()
     , cylinder(cylinder)
 {
 }
 
-void CylinderTrampoline::msgpack_pack(msgpack::packer<std::stringstream>& o) const
-{
-    o.pack_map(6);
-    PACK_MAP_VAR_FROM_INNER_CLASS(o, cylinder, type);
-    PACK_MAP_VAR(o, uuid);
-    PACK_MAP_VAR_WITH_NAME(o, radiusTop, cylinder.radius());
-    PACK_MAP_VAR_WITH_NAME(o, radiusBottom, cylinder.radius());
-    PACK_MAP_VAR_WITH_NAME(o, height, cylinder.height());
-    PACK_MAP_VAR(o, radialSegments);
-}
-
 BoxTrampoline::BoxTrampoline(const ::MeshcatCpp::Box& box)
     : GeometryData()
     , box(box)
 {
 }
 
-void BoxTrampoline::msgpack_pack(msgpack::packer<std::stringstream>& o) const
-{
-    o.pack_map(5);
-    PACK_MAP_VAR_FROM_INNER_CLASS(o, box, type);
-    PACK_MAP_VAR(o, uuid);
-    PACK_MAP_VAR_WITH_NAME(o, width, box.width());
-    PACK_MAP_VAR_WITH_NAME(o, height, box.depth());
-    PACK_MAP_VAR_WITH_NAME(o, depth, box.height());
-}
-
 EllipsoidTrampoline::EllipsoidTrampoline(const ::MeshcatCpp::Ellipsoid& ellipsoid)
     : GeometryData()
     , ellipsoid(ellipsoid)
 {
 }
 
-void EllipsoidTrampoline::msgpack_pack(msgpack::packer<std::stringstream>& o) const
-{
-    constexpr int radius = 1;
-    o.pack_map(5);
-    PACK_MAP_VAR_FROM_INNER_CLASS(o, ellipsoid, type);
-    PACK_MAP_VAR(o, uuid);
-    PACK_MAP_VAR_WITH_NAME(o, radius, radius);
-    PACK_MAP_VAR(o, widthSegments);
-    PACK_MAP_VAR(o, heightSegments);
-}
-
 MeshTrampoline::MeshTrampoline(const ::MeshcatCpp::Mesh& mesh)
     : GeometryData()
     , mesh(mesh)
@@ -113,29 +68,42 @@ MeshTrampoline::MeshTrampoline(const ::MeshcatCpp::Mesh& mesh)
         return;
     }
     this->format = path.substr(pos + 1);
+    this->file = MeshFileCache::cache().stat(path);
+}
 
-    std::ifstream input(path, std::ios::binary | std::ios::ate);
-    if (!input.is_open())
+PointCloudTrampoline::PointCloudTrampoline(const ::MeshcatCpp::PointCloud& cloud)
+    : GeometryData()
+    , cloud(cloud)
+{
+}
+
+std::size_t PointCloudTrampoline::buffers_size() const
+{
+    const std::size_t number_of_values = 3 * this->cloud.number_of_points();
+    std::size_t size = number_of_values * sizeof(float);
+    if (this->cloud.has_colors())
     {
-        return;
+        size += number_of_values * sizeof(uint8_t);
     }
+    return size;
+}
 
-    const int size = input.tellg();
-
-    input.seekg(0, std::ios::beg);
-    this->data.resize(size);
-    input.read(this->data.data(), size);
-
-    input.close();
+TriangleMeshTrampoline::TriangleMeshTrampoline(const ::MeshcatCpp::TriangleMesh& mesh)
+    : GeometryData()
+    , mesh(mesh)
+{
 }
 
-void MeshTrampoline::msgpack_pack(msgpack::packer<std::stringstream>& o) const
+std::size_t TriangleMeshTrampoline::buffers_size() const
 {
-    o.pack_map(4);
-    PACK_MAP_VAR_FROM_INNER_CLASS(o, mesh, type);
-    PACK_MAP_VAR(o, uuid);
-    PACK_MAP_VAR(o, format);
-    PACK_MAP_VAR(o, data);
+    const std::size_t number_of_vertex_values = 3 * this->mesh.number_of_vertices();
+    std::size_t size = number_of_vertex_values * sizeof(float);
+    if (this->mesh.has_normals())
+    {
+        size += number_of_vertex_values * sizeof(float);
+    }
+    size += 3 * this->mesh.number_of_faces() * sizeof(uint32_t);
+    return size;
 }
 
 MeshData::MeshData()
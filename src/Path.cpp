@@ -0,0 +1,50 @@
+/**
+ * @file Path.cpp
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#include <MeshcatCpp/impl/Path.h>
+
+std::string MeshcatCpp::details::absolute_path(std::string_view path, std::string_view prefix)
+{
+    std::string absolute;
+    absolute.reserve(prefix.size() + path.size() + 1);
+    absolute_path(path, prefix, absolute);
+    return absolute;
+}
+
+void MeshcatCpp::details::absolute_path(std::string_view path,
+                                        std::string_view prefix,
+                                        std::string& absolute)
+{
+    constexpr char separator = '/';
+
+    absolute.clear();
+    if (path.empty() || path.front() != separator)
+    {
+        absolute = prefix;
+    }
+
+    while (!path.empty())
+    {
+        const auto loc = path.find(separator);
+        const std::string_view segment = path.substr(0, loc);
+        if (!segment.empty())
+        {
+            absolute += separator;
+            absolute.append(segment);
+        }
+        if (loc == std::string_view::npos)
+        {
+            break;
+        }
+        path.remove_prefix(loc + 1);
+    }
+
+    if (absolute.empty())
+    {
+        absolute = prefix;
+    }
+}
@@ -0,0 +1,47 @@
+/**
+ * @file PoseKernel.cpp
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#include <MeshcatCpp/impl/PoseKernel.h>
+
+#include <algorithm>
+
+using namespace MeshcatCpp::details;
+
+void PoseBlock::compute_rotations(std::size_t count)
+{
+    const auto& [x, y, z, w] = this->quaternions;
+    auto& r = this->rotations;
+
+    const std::size_t end = std::min(count, size);
+    for (std::size_t i = 0; i < end; i++)
+    {
+        const double xx = x[i] * x[i];
+        const double yy = y[i] * y[i];
+        const double zz = z[i] * z[i];
+        const double ww = w[i] * w[i];
+        const double xy = x[i] * y[i];
+        const double xz = x[i] * z[i];
+        const double yz = y[i] * z[i];
+        const double xw = x[i] * w[i];
+        const double yw = y[i] * w[i];
+        const double zw = z[i] * w[i];
+
+        // Dividing by the squared norm makes the result a rotation matrix even if the quaternion
+        // is not normalized.
+        const double s = 2.0 / (xx + yy + zz + ww);
+
+        r[0][i] = 1.0 - s * (yy + zz);
+        r[1][i] = s * (xy + zw);
+        r[2][i] = s * (xz - yw);
+        r[3][i] = s * (xy - zw);
+        r[4][i] = 1.0 - s * (xx + zz);
+        r[5][i] = s * (yz + xw);
+        r[6][i] = s * (xz + yw);
+        r[7][i] = s * (yz - xw);
+        r[8][i] = 1.0 - s * (xx + yy);
+    }
+}
@@ -0,0 +1,205 @@
+/**
+ * @file Recording.cpp
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#include <MeshcatCpp/impl/Recording.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace MeshcatCpp::details;
+
+namespace
+{
+
+struct RecordHeader
+{
+    std::uint64_t time;
+    std::uint32_t size;
+};
+
+constexpr std::size_t record_header_size = sizeof(std::uint64_t) + sizeof(std::uint32_t);
+
+/**
+ * Read a big endian unsigned integer of n bytes.
+ */
+bool read_big_endian(std::string_view& data, std::size_t n, std::uint32_t& value)
+{
+    if (data.size() < n)
+    {
+        return false;
+    }
+    value = 0;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        value = (value << 8) | static_cast<std::uint8_t>(data[i]);
+    }
+    data.remove_prefix(n);
+    return true;
+}
+
+bool read_map_header(std::string_view& data, std::uint32_t& size)
+{
+    if (data.empty())
+    {
+        return false;
+    }
+    const auto tag = static_cast<std::uint8_t>(data.front());
+    data.remove_prefix(1);
+    if ((tag & 0xF0) == 0x80)
+    {
+        size = tag & 0x0F;
+        return true;
+    }
+    if (tag == 0xDE)
+    {
+        return read_big_endian(data, 2, size);
+    }
+    if (tag == 0xDF)
+    {
+        return read_big_endian(data, 4, size);
+    }
+    return false;
+}
+
+bool read_string(std::string_view& data, std::string_view& value)
+{
+    if (data.empty())
+    {
+        return false;
+    }
+    const auto tag = static_cast<std::uint8_t>(data.front());
+    data.remove_prefix(1);
+
+    std::uint32_t size = 0;
+    if ((tag & 0xE0) == 0xA0)
+    {
+        size = tag & 0x1F;
+    } else if (tag == 0xD9 || tag == 0xDA || tag == 0xDB)
+    {
+        if (!read_big_endian(data, std::size_t(1) << (tag - 0xD9), size))
+        {
+            return false;
+        }
+    } else
+    {
+        return false;
+    }
+
+    if (data.size() < size)
+    {
+        return false;
+    }
+    value = data.substr(0, size);
+    data.remove_prefix(size);
+    return true;
+}
+
+} // namespace
+
+RecordingWriter::RecordingWriter(const std::string& path)
+    : file_(path, MappedFile::Mode::Write)
+    , start_(std::chrono::steady_clock::now())
+{
+    this->file_.append(recording_magic.data(), recording_magic.size());
+}
+
+void RecordingWriter::append(std::string_view message)
+{
+    const auto elapsed = std::chrono::steady_clock::now() - this->start_;
+    const RecordHeader header{
+        .time = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+        .size = static_cast<std::uint32_t>(message.size())};
+
+    char buffer[record_header_size];
+    std::memcpy(buffer, &header.time, sizeof(header.time));
+    std::memcpy(buffer + sizeof(header.time), &header.size, sizeof(header.size));
+    this->file_.append(buffer, record_header_size);
+    this->file_.append(message.data(), message.size());
+}
+
+RecordingReader::RecordingReader(const std::string& path)
+    : file_(path, MappedFile::Mode::Read)
+{
+    std::string_view data(this->file_.data(), this->file_.size());
+    if (data.substr(0, recording_magic.size()) != recording_magic)
+    {
+        throw std::runtime_error("The file " + path + " is not a Meshcat recording.");
+    }
+    data.remove_prefix(recording_magic.size());
+
+    while (data.size() >= record_header_size)
+    {
+        RecordHeader header;
+        std::memcpy(&header.time, data.data(), sizeof(header.time));
+        std::memcpy(&header.size, data.data() + sizeof(header.time), sizeof(header.size));
+        data.remove_prefix(record_header_size);
+
+        // A recording that was not closed properly ends with the zeros reserved for the mapping.
+        if (header.size == 0 || data.size() < header.size)
+        {
+            break;
+        }
+
+        this->records_.push_back(Record{.time = header.time,
+                                        .message = data.substr(0, header.size)});
+        data.remove_prefix(header.size);
+    }
+}
+
+const std::vector<RecordingReader::Record>& RecordingReader::records() const
+{
+    return this->records_;
+}
+
+std::size_t RecordingReader::upper_bound(std::uint64_t time) const
+{
+    const auto it = std::upper_bound(this->records_.begin(),
+                                     this->records_.end(),
+                                     time,
+                                     [](std::uint64_t t, const Record& record) {
+                                         return t < record.time;
+                                     });
+    return static_cast<std::size_t>(std::distance(this->records_.begin(), it));
+}
+
+bool MeshcatCpp::details::parse_message_header(std::string_view message, MessageHeader& header)
+{
+    header = MessageHeader{};
+
+    std::uint32_t size = 0;
+    if (!read_map_header(message, size))
+    {
+        return false;
+    }
+
+    // The entries are read until a value that is not a string is found (e.g. the object or the
+    // matrix). Meshcat packs the type, the path and the property first.
+    for (std::uint32_t i = 0; i < size; i++)
+    {
+        std::string_view key;
+        std::string_view value;
+        if (!read_string(message, key) || !read_string(message, value))
+        {
+            break;
+        }
+
+        if (key == "type")
+        {
+            header.type = value;
+        } else if (key == "path")
+        {
+            header.path = value;
+        } else if (key == "property")
+        {
+            header.property = value;
+        }
+    }
+
+    return !header.type.empty();
+}
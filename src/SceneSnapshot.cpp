@@ -0,0 +1,188 @@
+/**
+ * @file SceneSnapshot.cpp
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#include <MeshcatCpp/impl/SceneSnapshot.h>
+
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+using namespace MeshcatCpp::details;
+
+MessageArena::Header MessageArena::header(std::size_t offset) const
+{
+    Header header;
+    std::memcpy(&header, this->data_.data() + offset, sizeof(Header));
+    return header;
+}
+
+void MessageArena::set_header(std::size_t offset, const Header& header)
+{
+    std::memcpy(this->data_.data() + offset, &header, sizeof(Header));
+}
+
+void MessageArena::mark_dead(std::size_t slot)
+{
+    const std::size_t offset = this->offsets_[slot];
+    Header header = this->header(offset);
+    header.slot = dead_slot;
+    this->set_header(offset, header);
+    this->dead_bytes_ += sizeof(Header) + header.size;
+}
+
+void MessageArena::store(std::size_t& slot, std::string_view msg)
+{
+    if (slot != npos)
+    {
+        const std::size_t offset = this->offsets_[slot];
+        if (this->header(offset).size == msg.size())
+        {
+            std::memcpy(this->data_.data() + offset + sizeof(Header), msg.data(), msg.size());
+            return;
+        }
+        this->mark_dead(slot);
+    } else if (!this->free_slots_.empty())
+    {
+        slot = this->free_slots_.back();
+        this->free_slots_.pop_back();
+    } else
+    {
+        slot = this->offsets_.size();
+        this->offsets_.push_back(npos);
+    }
+
+    assert(slot < dead_slot);
+    const std::size_t offset = this->data_.size();
+    this->offsets_[slot] = offset;
+    this->data_.resize(offset + sizeof(Header));
+    this->set_header(offset,
+                     Header{.size = static_cast<std::uint32_t>(msg.size()),
+                            .slot = static_cast<std::uint32_t>(slot)});
+    this->data_.append(msg.data(), msg.size());
+
+    this->compact();
+}
+
+void MessageArena::erase(std::size_t& slot)
+{
+    if (slot == npos)
+    {
+        return;
+    }
+
+    this->mark_dead(slot);
+    this->offsets_[slot] = npos;
+    this->free_slots_.push_back(slot);
+    slot = npos;
+
+    this->compact();
+}
+
+void MessageArena::compact()
+{
+    const std::size_t live_bytes = this->data_.size() - this->dead_bytes_;
+    if (this->dead_bytes_ < min_compaction_size || this->dead_bytes_ < live_bytes)
+    {
+        return;
+    }
+
+    // The live messages are moved towards the beginning of the buffer keeping their order.
+    std::size_t source = 0;
+    std::size_t destination = 0;
+    while (source < this->data_.size())
+    {
+        const Header header = this->header(source);
+        const std::size_t size = sizeof(Header) + header.size;
+        if (header.slot != dead_slot)
+        {
+            std::memmove(this->data_.data() + destination, this->data_.data() + source, size);
+            this->offsets_[header.slot] = destination;
+            destination += size;
+        }
+        source += size;
+    }
+
+    this->data_.resize(destination);
+    this->dead_bytes_ = 0;
+}
+
+ObjectMessage& SceneSnapshot::object_slot(std::size_t& slot)
+{
+    if (slot == npos)
+    {
+        if (!this->free_objects_.empty())
+        {
+            slot = this->free_objects_.back();
+            this->free_objects_.pop_back();
+        } else
+        {
+            slot = this->objects_.size();
+            this->objects_.emplace_back();
+        }
+    }
+
+    auto& object = this->objects_[slot];
+    if (!object)
+    {
+        object.emplace();
+    }
+    return object.value();
+}
+
+void SceneSnapshot::store_object(std::size_t& slot, ObjectMessage&& message)
+{
+    this->object_slot(slot) = std::move(message);
+}
+
+void SceneSnapshot::store_object(std::size_t& slot, SharedMessage msg)
+{
+    ObjectMessage message;
+    message.head = std::move(msg);
+    this->object_slot(slot) = std::move(message);
+}
+
+void SceneSnapshot::store_transform(std::size_t& slot, std::string_view msg)
+{
+    this->transforms_.store(slot, msg);
+}
+
+void SceneSnapshot::store_property(std::size_t& slot, std::string_view msg)
+{
+    this->properties_.store(slot, msg);
+}
+
+void SceneSnapshot::store_animation(SharedMessage msg)
+{
+    this->animation_ = std::move(msg);
+}
+
+void SceneSnapshot::erase_animation()
+{
+    this->animation_ = SharedMessage();
+}
+
+void SceneSnapshot::erase_object(std::size_t& slot)
+{
+    if (slot == npos)
+    {
+        return;
+    }
+
+    this->objects_[slot].reset();
+    this->free_objects_.push_back(slot);
+    slot = npos;
+}
+
+void SceneSnapshot::erase_transform(std::size_t& slot)
+{
+    this->transforms_.erase(slot);
+}
+
+void SceneSnapshot::erase_property(std::size_t& slot)
+{
+    this->properties_.erase(slot);
+}
@@ -7,6 +7,8 @@
 
 #include <MeshcatCpp/Shape.h>
 
+#include <stdexcept>
+
 using namespace MeshcatCpp;
 
 Sphere::Sphere(double radius)
@@ -44,3 +46,91 @@ Mesh::Mesh(std::string_view file_path, double scale)
     , scale_(std::move(scale))
 {
 }
+
+namespace
+{
+template <typename T> bool has_contiguous_triplets(const MatrixView<const T>& matrix)
+{
+    constexpr typename MatrixView<const T>::index_type size = 3;
+    return (matrix.rows() == size && matrix.storageOrder() == MatrixStorageOrdering::ColumnMajor)
+           || (matrix.cols() == size && matrix.storageOrder() == MatrixStorageOrdering::RowMajor);
+}
+
+template <typename T> std::size_t number_of_columns(const MatrixView<const T>& matrix)
+{
+    return static_cast<std::size_t>(matrix.rows() * matrix.cols() / 3);
+}
+} // namespace
+
+PointCloud::PointCloud(const MatrixView<const float>& positions,
+                       const MatrixView<const uint8_t>& colors)
+    : Shape{.type = "BufferGeometry"}
+    , positions_(positions)
+    , colors_(colors)
+{
+    if (!has_contiguous_triplets(positions))
+    {
+        throw std::runtime_error("The positions must be a 3xN column major matrix or a Nx3 row "
+                                 "major matrix.");
+    }
+
+    if (colors.data() != nullptr
+        && (!has_contiguous_triplets(colors)
+            || number_of_columns(colors) != number_of_columns(positions)))
+    {
+        throw std::runtime_error("The colors must have the same layout of the positions.");
+    }
+}
+
+std::size_t PointCloud::number_of_points() const
+{
+    return number_of_columns(this->positions_);
+}
+
+bool PointCloud::has_colors() const
+{
+    return this->colors_.data() != nullptr;
+}
+
+TriangleMesh::TriangleMesh(const MatrixView<const float>& vertices,
+                           const MatrixView<const uint32_t>& faces,
+                           const MatrixView<const float>& normals)
+    : Shape{.type = "BufferGeometry"}
+    , vertices_(vertices)
+    , faces_(faces)
+    , normals_(normals)
+{
+    if (!has_contiguous_triplets(vertices))
+    {
+        throw std::runtime_error("The vertices must be a 3xN column major matrix or a Nx3 row "
+                                 "major matrix.");
+    }
+
+    if (!has_contiguous_triplets(faces))
+    {
+        throw std::runtime_error("The faces must be a 3xM column major matrix or a Mx3 row major "
+                                 "matrix.");
+    }
+
+    if (normals.data() != nullptr
+        && (!has_contiguous_triplets(normals)
+            || number_of_columns(normals) != number_of_columns(vertices)))
+    {
+        throw std::runtime_error("The normals must have the same layout of the vertices.");
+    }
+}
+
+std::size_t TriangleMesh::number_of_vertices() const
+{
+    return number_of_columns(this->vertices_);
+}
+
+std::size_t TriangleMesh::number_of_faces() const
+{
+    return number_of_columns(this->faces_);
+}
+
+bool TriangleMesh::has_normals() const
+{
+    return this->normals_.data() != nullptr;
+}
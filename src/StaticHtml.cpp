@@ -0,0 +1,140 @@
+/**
+ * @file StaticHtml.cpp
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#include <MeshcatCpp/impl/StaticHtml.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace MeshcatCpp::details;
+
+namespace
+{
+
+constexpr std::string_view main_min_js_tag
+    = R"(<script type="text/javascript" src="main.min.js"></script>)";
+constexpr std::string_view embedded_tag = R"(<script id="embedded-json"></script>)";
+
+constexpr std::string_view embedded_head = R"(<script id="embedded-json">
+            function base64_to_bytes(text) {
+                const binary = atob(text);
+                const bytes = new Uint8Array(binary.length);
+                for (let i = 0; i < binary.length; i++) {
+                    bytes[i] = binary.charCodeAt(i);
+                }
+                return bytes;
+            }
+)";
+constexpr std::string_view embedded_tail = "        </script>";
+
+constexpr std::string_view message_head = "            viewer.handle_command_bytearray("
+                                          "base64_to_bytes(\"";
+constexpr std::string_view message_tail = "\"));\n";
+
+constexpr std::string_view base64_alphabet
+    = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+} // namespace
+
+StaticHtmlWriter::StaticHtmlWriter(const std::string& path,
+                                   std::string_view index_html,
+                                   std::string_view main_min_js)
+{
+    const std::size_t script = index_html.find(main_min_js_tag);
+    const std::size_t embedded = index_html.find(embedded_tag);
+    if (script == std::string_view::npos || embedded == std::string_view::npos
+        || embedded < script)
+    {
+        throw std::runtime_error("Unexpected index.html, unable to export the scene.");
+    }
+
+    this->file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!this->file_)
+    {
+        throw std::runtime_error("Unable to open " + path + ".");
+    }
+
+    // The viewer must be defined before its page script runs, hence it is embedded in place of
+    // the script tag that loads it.
+    this->write(index_html.substr(0, script));
+    this->write(R"(<script type="text/javascript">)");
+    this->write(main_min_js);
+    this->write("</script>");
+    const std::size_t middle = script + main_min_js_tag.size();
+    this->write(index_html.substr(middle, embedded - middle));
+    this->write(embedded_head);
+    this->tail_ = index_html.substr(embedded + embedded_tag.size());
+}
+
+void StaticHtmlWriter::add_message(std::string_view message)
+{
+    this->write(message_head);
+
+    const auto* data = reinterpret_cast<const unsigned char*>(message.data());
+    const std::size_t size = message.size();
+    std::size_t i = 0;
+    std::array<char, 4> quartet;
+    for (; i + 3 <= size; i += 3)
+    {
+        const unsigned int triplet = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+        quartet = {base64_alphabet[(triplet >> 18) & 0x3F],
+                   base64_alphabet[(triplet >> 12) & 0x3F],
+                   base64_alphabet[(triplet >> 6) & 0x3F],
+                   base64_alphabet[triplet & 0x3F]};
+        this->write(std::string_view(quartet.data(), quartet.size()));
+    }
+
+    if (i < size)
+    {
+        const bool has_second = i + 1 < size;
+        const unsigned int triplet = (data[i] << 16) | (has_second ? data[i + 1] << 8 : 0);
+        quartet = {base64_alphabet[(triplet >> 18) & 0x3F],
+                   base64_alphabet[(triplet >> 12) & 0x3F],
+                   has_second ? base64_alphabet[(triplet >> 6) & 0x3F] : '=',
+                   '='};
+        this->write(std::string_view(quartet.data(), quartet.size()));
+    }
+
+    this->write(message_tail);
+}
+
+void StaticHtmlWriter::finish()
+{
+    this->write(embedded_tail);
+    this->write(this->tail_);
+    this->flush();
+    this->file_.close();
+    if (!this->file_)
+    {
+        throw std::runtime_error("Unable to write the exported scene.");
+    }
+}
+
+void StaticHtmlWriter::write(std::string_view text)
+{
+    while (!text.empty())
+    {
+        if (this->size_ == this->buffer_.size())
+        {
+            this->flush();
+        }
+        const std::size_t count = std::min(text.size(), this->buffer_.size() - this->size_);
+        std::copy_n(text.data(), count, this->buffer_.data() + this->size_);
+        this->size_ += count;
+        text.remove_prefix(count);
+    }
+}
+
+void StaticHtmlWriter::flush()
+{
+    this->file_.write(this->buffer_.data(), static_cast<std::streamsize>(this->size_));
+    this->size_ = 0;
+    if (!this->file_)
+    {
+        throw std::runtime_error("Unable to write the exported scene.");
+    }
+}
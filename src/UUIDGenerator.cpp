@@ -24,3 +24,9 @@ std::string UUIDGenerator::operator()()
     uuids::uuid_random_generator uuid_generator{this->generator_};
     return uuids::to_string(uuid_generator());
 }
+
+std::string UUIDGenerator::from_name(std::string_view name)
+{
+    uuids::uuid_name_generator uuid_generator{uuids::uuid_namespace_url};
+    return uuids::to_string(uuid_generator(name));
+}
@@ -0,0 +1,126 @@
+/**
+ * @file CommandQueueTest.cpp
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#include <MeshcatCpp/impl/CommandQueue.h>
+
+#include "TestUtils.h"
+
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using MeshcatCpp::details::CommandQueue;
+
+void test_capacity()
+{
+    MESHCAT_CPP_CHECK(CommandQueue<int>(1).capacity() == 2);
+    MESHCAT_CPP_CHECK(CommandQueue<int>(4).capacity() == 4);
+    MESHCAT_CPP_CHECK(CommandQueue<int>(5).capacity() == 8);
+}
+
+void test_wraparound()
+{
+    // The positions wrap around the ring many times.
+    CommandQueue<int> queue(4);
+    int value = 0;
+    for (int round = 0; round < 100; round++)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            int pushed = 3 * round + i;
+            MESHCAT_CPP_CHECK(queue.push(pushed));
+        }
+        for (int i = 0; i < 3; i++)
+        {
+            MESHCAT_CPP_CHECK(queue.pop(value));
+            MESHCAT_CPP_CHECK(value == 3 * round + i);
+        }
+        MESHCAT_CPP_CHECK(!queue.pop(value));
+    }
+}
+
+void test_full()
+{
+    CommandQueue<std::string> queue(4);
+    for (int i = 0; i < 4; i++)
+    {
+        std::string value = std::to_string(i);
+        MESHCAT_CPP_CHECK(queue.push(value));
+    }
+
+    // A rejected element is not moved.
+    std::string rejected = "rejected";
+    MESHCAT_CPP_CHECK(!queue.push(rejected));
+    MESHCAT_CPP_CHECK(rejected == "rejected");
+
+    std::string value;
+    MESHCAT_CPP_CHECK(queue.pop(value));
+    MESHCAT_CPP_CHECK(value == "0");
+    MESHCAT_CPP_CHECK(queue.push(rejected));
+
+    const std::vector<std::string> expected = {"1", "2", "3", "rejected"};
+    for (const auto& element : expected)
+    {
+        MESHCAT_CPP_CHECK(queue.pop(value));
+        MESHCAT_CPP_CHECK(value == element);
+    }
+    MESHCAT_CPP_CHECK(!queue.pop(value));
+}
+
+void test_producers()
+{
+    // Each producer pushes an increasing sequence, so the consumer must see the elements of each
+    // producer in order.
+    constexpr int producers = 4;
+    constexpr int elements = 10000;
+    CommandQueue<std::pair<int, int>> queue(64);
+
+    std::vector<std::thread> threads;
+    for (int producer = 0; producer < producers; producer++)
+    {
+        threads.emplace_back([&queue, producer]() {
+            for (int i = 0; i < elements; i++)
+            {
+                std::pair<int, int> value{producer, i};
+                while (!queue.push(value))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<int> next(producers, 0);
+    std::pair<int, int> value;
+    for (int popped = 0; popped < producers * elements;)
+    {
+        if (!queue.pop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        MESHCAT_CPP_CHECK(value.second == next[value.first]);
+        next[value.first] = value.second + 1;
+        popped++;
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    MESHCAT_CPP_CHECK(!queue.pop(value));
+}
+
+int main()
+{
+    test_capacity();
+    test_wraparound();
+    test_full();
+    test_producers();
+    return MeshcatCpp::test::result();
+}
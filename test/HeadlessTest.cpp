@@ -0,0 +1,231 @@
+/**
+ * @file HeadlessTest.cpp
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#include <MeshcatCpp/Meshcat.h>
+#include <MeshcatCpp/MeshcatParams.h>
+#include <MeshcatCpp/Shape.h>
+
+#include "TestUtils.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using MeshcatCpp::test::Message;
+using MeshcatCpp::test::MessageLog;
+
+MeshcatCpp::MeshcatParams headless_params(MessageLog& log)
+{
+    MeshcatCpp::MeshcatParams params;
+    params.transport = MeshcatCpp::MeshcatParams::Transport::Headless;
+    params.message_sink = [&log](std::string_view msg) { log.add(msg); };
+    return params;
+}
+
+std::array<double, 16> identity()
+{
+    return {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+}
+
+std::size_t count(const std::vector<Message>& messages, const std::string& type)
+{
+    return static_cast<std::size_t>(
+        std::count_if(messages.begin(), messages.end(), [&type](const Message& message) {
+            return message.type == type;
+        }));
+}
+
+/**
+ * Get the number of messages embedded in an exported page.
+ */
+std::size_t exported_messages(const std::string& path)
+{
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    const std::string page = content.str();
+
+    constexpr std::string_view command = "handle_command_bytearray(";
+    std::size_t messages = 0;
+    for (auto pos = page.find(command); pos != std::string::npos;
+         pos = page.find(command, pos + command.size()))
+    {
+        messages++;
+    }
+    return messages;
+}
+
+void check_messages(const std::vector<Message>& messages, const std::vector<Message>& expected)
+{
+    MESHCAT_CPP_CHECK(messages == expected);
+    if (messages != expected)
+    {
+        std::cerr << "Received messages:" << std::endl;
+        MeshcatCpp::test::print(messages);
+    }
+}
+
+void test_sequence()
+{
+    // The destructor waits until the websocket thread publishes all the queued commands.
+    MessageLog log;
+    {
+        MeshcatCpp::Meshcat meshcat(headless_params(log));
+        auto transform = identity();
+        meshcat.set_object("box", MeshcatCpp::Box(0.5, 0.5, 0.5));
+        meshcat.set_transform("/meshcat/box", MeshcatCpp::make_matrix_view(transform.data(), 4, 4));
+        meshcat.set_property("box/", "visible", false);
+        meshcat.delete_object("box");
+    }
+
+    check_messages(log.messages(),
+                   {{"set_object", "/meshcat/box", ""},
+                    {"set_transform", "/meshcat/box", ""},
+                    {"set_property", "/meshcat/box", "visible"},
+                    {"delete", "/meshcat/box", ""}});
+}
+
+void test_conflation()
+{
+    // The transforms set during a frame are conflated, hence only the latest is published.
+    constexpr int updates = 100;
+    MessageLog log;
+    {
+        auto params = headless_params(log);
+        params.conflate_updates = true;
+        params.max_publish_rate = 20;
+        MeshcatCpp::Meshcat meshcat(params);
+
+        auto transform = identity();
+        meshcat.set_object("box", MeshcatCpp::Box(0.5, 0.5, 0.5));
+        for (int i = 0; i < updates; i++)
+        {
+            transform[12] = i;
+            meshcat.set_transform("box", MeshcatCpp::make_matrix_view(transform.data(), 4, 4));
+        }
+
+        MESHCAT_CPP_CHECK(log.wait_for(2));
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+
+    const auto messages = log.messages();
+    MESHCAT_CPP_CHECK(!messages.empty() && messages.front().type == "set_object");
+    MESHCAT_CPP_CHECK(count(messages, "set_transform") >= 1);
+    MESHCAT_CPP_CHECK(count(messages, "set_transform") < 10);
+}
+
+void test_static_html()
+{
+    const std::string path
+        = (std::filesystem::temp_directory_path() / "MeshcatCppHeadlessTest.html").string();
+    const std::string sink_path
+        = (std::filesystem::temp_directory_path() / "MeshcatCppHeadlessTestSink.html").string();
+
+    // The page is also exported from the sink, i.e. from the websocket thread. The property is
+    // published before being stored, so that page contains the object and the transform.
+    MessageLog log;
+    MeshcatCpp::Meshcat* instance = nullptr;
+    auto params = headless_params(log);
+    params.message_sink = [&log, &instance, &sink_path](std::string_view msg) {
+        log.add(msg);
+        if (MeshcatCpp::test::parse_message(msg).type == "set_property")
+        {
+            instance->export_static_html(sink_path);
+        }
+    };
+
+    MeshcatCpp::Meshcat meshcat(params);
+    instance = &meshcat;
+    auto transform = identity();
+    meshcat.set_object("box", MeshcatCpp::Box(0.5, 0.5, 0.5));
+    meshcat.set_transform("box", MeshcatCpp::make_matrix_view(transform.data(), 4, 4));
+    meshcat.set_property("box", "visible", false);
+    meshcat.export_static_html(path);
+
+    MESHCAT_CPP_CHECK(exported_messages(path) == 3);
+    MESHCAT_CPP_CHECK(exported_messages(sink_path) == 2);
+    std::filesystem::remove(path);
+    std::filesystem::remove(sink_path);
+}
+
+void test_reentrant_calls()
+{
+    // The sink calls the API while the queue is full. The commands are kept by the websocket
+    // thread instead of waiting for itself.
+    constexpr int updates = 16;
+    MessageLog log;
+    MeshcatCpp::Meshcat* instance = nullptr;
+    auto params = headless_params(log);
+    params.command_queue_capacity = 2;
+    params.message_sink = [&log, &instance](std::string_view msg) {
+        log.add(msg);
+        if (MeshcatCpp::test::parse_message(msg).type != "set_object")
+        {
+            return;
+        }
+        auto transform = identity();
+        for (int i = 0; i < updates; i++)
+        {
+            transform[12] = i;
+            instance->set_transform("box", MeshcatCpp::make_matrix_view(transform.data(), 4, 4));
+        }
+    };
+
+    {
+        MeshcatCpp::Meshcat meshcat(params);
+        instance = &meshcat;
+        meshcat.set_object("box", MeshcatCpp::Box(0.5, 0.5, 0.5));
+        MESHCAT_CPP_CHECK(log.wait_for(1 + updates));
+    }
+
+    const auto messages = log.messages();
+    MESHCAT_CPP_CHECK(messages.size() == 1 + updates);
+    MESHCAT_CPP_CHECK(count(messages, "set_transform") == updates);
+}
+
+void test_deleted_point_cloud(bool conflate_updates)
+{
+    // The point cloud updated before the deletion must not be published after it.
+    MessageLog log;
+    {
+        auto params = headless_params(log);
+        params.conflate_updates = conflate_updates;
+        MeshcatCpp::Meshcat meshcat(params);
+
+        std::array<float, 6> positions = {0, 0, 0, 1, 1, 1};
+        const MeshcatCpp::PointCloud cloud(MeshcatCpp::make_matrix_view(positions.data(), 2, 3));
+        for (int i = 0; i < 10; i++)
+        {
+            meshcat.update_point_cloud("cloud", cloud);
+            meshcat.delete_object("cloud");
+        }
+    }
+
+    const auto messages = log.messages();
+    MESHCAT_CPP_CHECK(count(messages, "delete") == 10);
+    MESHCAT_CPP_CHECK(!messages.empty() && messages.back().type == "delete");
+}
+
+int main()
+{
+    test_sequence();
+    test_conflation();
+    test_static_html();
+    test_reentrant_calls();
+    test_deleted_point_cloud(false);
+    test_deleted_point_cloud(true);
+    return MeshcatCpp::test::result();
+}
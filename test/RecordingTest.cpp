@@ -0,0 +1,145 @@
+/**
+ * @file RecordingTest.cpp
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#include <MeshcatCpp/Meshcat.h>
+#include <MeshcatCpp/MeshcatParams.h>
+#include <MeshcatCpp/Shape.h>
+#include <MeshcatCpp/impl/Recording.h>
+
+#include "TestUtils.h"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using MeshcatCpp::details::RecordingReader;
+using MeshcatCpp::details::RecordingWriter;
+using MeshcatCpp::test::Message;
+using MeshcatCpp::test::MessageLog;
+
+std::string temporary_path(const std::string& name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void test_round_trip()
+{
+    const std::string path = temporary_path("MeshcatCppRecordingTest.rec");
+
+    // The large message forces the mapping to grow.
+    const std::vector<std::string> messages
+        = {"first", std::string(4 * 1024 * 1024, 'x'), "last"};
+    {
+        RecordingWriter writer(path);
+        for (const auto& message : messages)
+        {
+            writer.append(message);
+        }
+    }
+
+    RecordingReader reader(path);
+    const auto& records = reader.records();
+    MESHCAT_CPP_CHECK(records.size() == messages.size());
+    for (std::size_t i = 0; i < records.size() && i < messages.size(); i++)
+    {
+        MESHCAT_CPP_CHECK(records[i].message == messages[i]);
+        MESHCAT_CPP_CHECK(i == 0 || records[i - 1].time <= records[i].time);
+    }
+    if (!records.empty())
+    {
+        MESHCAT_CPP_CHECK(reader.upper_bound(records.back().time) == records.size());
+    }
+    std::filesystem::remove(path);
+}
+
+void test_invalid_file()
+{
+    const std::string path = temporary_path("MeshcatCppRecordingTest.txt");
+    std::ofstream(path) << "not a recording";
+
+    bool thrown = false;
+    try
+    {
+        RecordingReader reader(path);
+    } catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    MESHCAT_CPP_CHECK(thrown);
+    std::filesystem::remove(path);
+}
+
+void test_meshcat_recording()
+{
+    const std::string path = temporary_path("MeshcatCppMeshcatRecordingTest.rec");
+
+    // The recording contains the messages passed to the sink.
+    MessageLog published;
+    {
+        MeshcatCpp::MeshcatParams params;
+        params.transport = MeshcatCpp::MeshcatParams::Transport::Headless;
+        params.recording_path = path;
+        params.message_sink = [&published](std::string_view msg) { published.add(msg); };
+
+        MeshcatCpp::Meshcat meshcat(params);
+        std::array<double, 16> transform = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+        const auto matrix = MeshcatCpp::make_matrix_view(transform.data(), 4, 4);
+        meshcat.set_object("box", MeshcatCpp::Box(0.5, 0.5, 0.5));
+        meshcat.set_transform("box", matrix);
+        meshcat.set_property("box", "visible", false);
+        meshcat.set_object("sphere", MeshcatCpp::Sphere(0.5));
+        meshcat.delete_object("sphere");
+    }
+
+    std::vector<Message> recorded;
+    {
+        RecordingReader reader(path);
+        for (const auto& record : reader.records())
+        {
+            recorded.push_back(MeshcatCpp::test::parse_message(record.message));
+        }
+    }
+    MESHCAT_CPP_CHECK(recorded.size() == 5);
+    MESHCAT_CPP_CHECK(recorded == published.messages());
+
+    // The replay clears the scene and publishes the recorded messages again. The replayed
+    // messages are not part of the recording of the instance that replays them.
+    const std::string replay_path = temporary_path("MeshcatCppMeshcatReplayTest.rec");
+    MessageLog replayed;
+    {
+        MeshcatCpp::MeshcatParams params;
+        params.transport = MeshcatCpp::MeshcatParams::Transport::Headless;
+        params.recording_path = replay_path;
+        params.message_sink = [&replayed](std::string_view msg) { replayed.add(msg); };
+
+        MeshcatCpp::Meshcat meshcat(params);
+        meshcat.replay(path, 1000);
+        MESHCAT_CPP_CHECK(replayed.wait_for(recorded.size() + 1));
+    }
+
+    std::vector<Message> expected = {{"delete", "/meshcat", ""}};
+    expected.insert(expected.end(), recorded.begin(), recorded.end());
+    MESHCAT_CPP_CHECK(replayed.messages() == expected);
+    if (replayed.messages() != expected)
+    {
+        MeshcatCpp::test::print(replayed.messages());
+    }
+    MESHCAT_CPP_CHECK(RecordingReader(replay_path).records().empty());
+    std::filesystem::remove(path);
+    std::filesystem::remove(replay_path);
+}
+
+int main()
+{
+    test_round_trip();
+    test_invalid_file();
+    test_meshcat_recording();
+    return MeshcatCpp::test::result();
+}
@@ -0,0 +1,142 @@
+/**
+ * @file SceneSnapshotTest.cpp
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#include <MeshcatCpp/impl/SceneSnapshot.h>
+
+#include "TestUtils.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <msgpack.hpp>
+
+using MeshcatCpp::details::MessageArena;
+using MeshcatCpp::details::SceneSnapshot;
+using MeshcatCpp::details::SharedMessage;
+using MeshcatCpp::details::SnapshotCursor;
+
+std::vector<std::string> messages(const MessageArena& arena)
+{
+    std::vector<std::string> result;
+    std::size_t slot = 0;
+    arena.resume(slot, [&result](std::string_view msg) {
+        result.emplace_back(msg);
+        return true;
+    });
+    return result;
+}
+
+void test_arena_patch()
+{
+    MessageArena arena;
+    std::size_t a = MessageArena::npos;
+    std::size_t b = MessageArena::npos;
+    std::size_t c = MessageArena::npos;
+    arena.store(a, "aaaa");
+    arena.store(b, "bbbb");
+    arena.store(c, "cccc");
+    MESHCAT_CPP_CHECK((messages(arena) == std::vector<std::string>{"aaaa", "bbbb", "cccc"}));
+
+    // A message with the same size is patched in place, a message with a different size is
+    // appended. In both cases the messages are visited in the order of their slots.
+    const std::size_t slot = b;
+    arena.store(b, "dddd");
+    MESHCAT_CPP_CHECK(b == slot);
+    MESHCAT_CPP_CHECK((messages(arena) == std::vector<std::string>{"aaaa", "dddd", "cccc"}));
+    arena.store(a, "eeeeeeee");
+    MESHCAT_CPP_CHECK((messages(arena) == std::vector<std::string>{"eeeeeeee", "dddd", "cccc"}));
+
+    // The slot of an erased message is reused.
+    arena.erase(b);
+    MESHCAT_CPP_CHECK(b == MessageArena::npos);
+    MESHCAT_CPP_CHECK((messages(arena) == std::vector<std::string>{"eeeeeeee", "cccc"}));
+    std::size_t f = MessageArena::npos;
+    arena.store(f, "ff");
+    MESHCAT_CPP_CHECK(f == slot);
+    MESHCAT_CPP_CHECK((messages(arena) == std::vector<std::string>{"eeeeeeee", "ff", "cccc"}));
+}
+
+void test_arena_compaction()
+{
+    // The message changes size at every store, hence the dead messages trigger the compaction
+    // several times.
+    MessageArena arena;
+    std::size_t first = MessageArena::npos;
+    std::size_t large = MessageArena::npos;
+    std::size_t last = MessageArena::npos;
+    arena.store(first, "first");
+    arena.store(large, std::string(1000, 'x'));
+    arena.store(last, "last");
+
+    std::string expected;
+    for (int i = 0; i < 500; i++)
+    {
+        expected.assign(1000 + i % 2, static_cast<char>('a' + i % 26));
+        arena.store(large, expected);
+    }
+    MESHCAT_CPP_CHECK((messages(arena) == std::vector<std::string>{"first", expected, "last"}));
+
+    arena.erase(first);
+    arena.erase(large);
+    MESHCAT_CPP_CHECK((messages(arena) == std::vector<std::string>{"last"}));
+}
+
+std::vector<std::string> messages(const SceneSnapshot& snapshot, std::size_t slice)
+{
+    // The snapshot is visited in slices of a given number of messages. The function returns false
+    // after the last message of a slice, as a socket that becomes congested.
+    std::vector<std::string> result;
+    msgpack::sbuffer buffer;
+    SnapshotCursor cursor;
+    while (!cursor.done())
+    {
+        std::size_t count = 0;
+        snapshot.resume(cursor, buffer, [&](std::string_view msg) {
+            result.emplace_back(msg);
+            return ++count < slice;
+        });
+    }
+    return result;
+}
+
+void test_snapshot()
+{
+    SceneSnapshot snapshot;
+    std::size_t box = SceneSnapshot::npos;
+    std::size_t sphere = SceneSnapshot::npos;
+    std::size_t transform = SceneSnapshot::npos;
+    std::size_t property = SceneSnapshot::npos;
+
+    // The objects are sent first, then the transforms, the properties and the animation.
+    snapshot.store_animation(SharedMessage(std::string("animation")));
+    snapshot.store_property(property, "property");
+    snapshot.store_transform(transform, "transform");
+    snapshot.store_object(box, SharedMessage(std::string("box")));
+    snapshot.store_object(sphere, SharedMessage(std::string("sphere")));
+
+    const std::vector<std::string> expected
+        = {"box", "sphere", "transform", "property", "animation"};
+    MESHCAT_CPP_CHECK(messages(snapshot, expected.size()) == expected);
+    MESHCAT_CPP_CHECK(messages(snapshot, 2) == expected);
+    MESHCAT_CPP_CHECK(messages(snapshot, 1) == expected);
+
+    snapshot.erase_object(box);
+    snapshot.erase_transform(transform);
+    snapshot.erase_animation();
+    MESHCAT_CPP_CHECK(box == SceneSnapshot::npos);
+    MESHCAT_CPP_CHECK((messages(snapshot, 1) == std::vector<std::string>{"sphere", "property"}));
+}
+
+int main()
+{
+    test_arena_patch();
+    test_arena_compaction();
+    test_snapshot();
+    return MeshcatCpp::test::result();
+}
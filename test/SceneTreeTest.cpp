@@ -0,0 +1,107 @@
+/**
+ * @file SceneTreeTest.cpp
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#include <MeshcatCpp/impl/SceneTree.h>
+
+#include "TestUtils.h"
+
+#include <cstdint>
+
+using MeshcatCpp::details::SceneTree;
+using MeshcatCpp::details::StringInterner;
+using Tree = SceneTree<int>;
+
+void test_interner()
+{
+    StringInterner names;
+    const auto box = names.intern("box");
+    MESHCAT_CPP_CHECK(names.intern("box") == box);
+    MESHCAT_CPP_CHECK(names.find("box") == box);
+    MESHCAT_CPP_CHECK(names.name(box) == "box");
+
+    // The string is removed when it is not referenced anymore and its id is reused.
+    names.release(box);
+    MESHCAT_CPP_CHECK(names.find("box") == box);
+    names.release(box);
+    MESHCAT_CPP_CHECK(names.find("box") == StringInterner::npos);
+    MESHCAT_CPP_CHECK(names.intern("sphere") == box);
+    MESHCAT_CPP_CHECK(names.name(box) == "sphere");
+}
+
+void test_lookup()
+{
+    Tree tree;
+    const Tree::Index node = tree["meshcat/robot/link"];
+    MESHCAT_CPP_CHECK(tree.size() == 4);
+    MESHCAT_CPP_CHECK(tree["meshcat/robot/link"] == node);
+    MESHCAT_CPP_CHECK(tree.size() == 4);
+
+    // The empty segments are ignored.
+    MESHCAT_CPP_CHECK(tree.find("/meshcat//robot/link/") == node);
+    MESHCAT_CPP_CHECK(tree.find("meshcat/robot/other") == Tree::npos);
+    MESHCAT_CPP_CHECK(tree.find("") == Tree::root);
+
+    // Two nodes with the same name and different parents are different nodes.
+    const Tree::Index other = tree["meshcat/other/link"];
+    MESHCAT_CPP_CHECK(other != node);
+    MESHCAT_CPP_CHECK(tree.size() == 6);
+}
+
+void test_erase()
+{
+    Tree tree;
+    const Tree::Index link = tree["meshcat/robot/link"];
+    const std::uint32_t generation = tree.generation(link);
+    tree.value(link) = 42;
+    const Tree::Index robot = tree.find("meshcat/robot");
+
+    int removed = 0;
+    int value = 0;
+    tree.erase(robot, [&](int& node_value) {
+        removed++;
+        value += node_value;
+    });
+    MESHCAT_CPP_CHECK(removed == 2);
+    MESHCAT_CPP_CHECK(value == 42);
+    MESHCAT_CPP_CHECK(tree.size() == 2);
+    MESHCAT_CPP_CHECK(tree.find("meshcat/robot") == Tree::npos);
+    MESHCAT_CPP_CHECK(tree.find("meshcat") != Tree::npos);
+    MESHCAT_CPP_CHECK(!tree.contains(link, generation));
+
+    // The indices are reused, but a stale index is detected through its generation.
+    const Tree::Index reused = tree["meshcat/robot/link"];
+    MESHCAT_CPP_CHECK(tree.value(reused) == 0);
+    MESHCAT_CPP_CHECK(tree.contains(reused, tree.generation(reused)));
+    if (reused == link)
+    {
+        MESHCAT_CPP_CHECK(tree.generation(reused) != generation);
+    }
+    MESHCAT_CPP_CHECK(!tree.contains(link, generation));
+}
+
+void test_erase_root()
+{
+    Tree tree;
+    tree["meshcat/a"];
+    tree["meshcat/b/c"];
+
+    int removed = 0;
+    tree.erase(Tree::root, [&](int&) { removed++; });
+    MESHCAT_CPP_CHECK(removed == 4);
+    MESHCAT_CPP_CHECK(tree.size() == 1);
+    MESHCAT_CPP_CHECK(tree.find("meshcat") == Tree::npos);
+    MESHCAT_CPP_CHECK(tree.contains(Tree::root, tree.generation(Tree::root)));
+}
+
+int main()
+{
+    test_interner();
+    test_lookup();
+    test_erase();
+    test_erase_root();
+    return MeshcatCpp::test::result();
+}
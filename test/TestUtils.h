@@ -0,0 +1,143 @@
+/**
+ * @file TestUtils.h
+ * @authors Giulio Romualdi
+ * @copyright This software may be modified and distributed under the terms of the BSD-3-Clause
+ * license.
+ */
+
+#ifndef MESHCAT_CPP_TEST_UTILS_H
+#define MESHCAT_CPP_TEST_UTILS_H
+
+#include <MeshcatCpp/impl/Recording.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * Check a condition. A failed check is reported and the test continues, so that all the failures
+ * are reported at once.
+ */
+#define MESHCAT_CPP_CHECK(condition)                                                              \
+    ::MeshcatCpp::test::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+namespace MeshcatCpp::test
+{
+
+inline int& failures()
+{
+    static int count = 0;
+    return count;
+}
+
+inline void check(bool condition, const char* expression, const char* file, int line)
+{
+    if (!condition)
+    {
+        std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+        failures()++;
+    }
+}
+
+/**
+ * Get the exit code of the test.
+ */
+inline int result()
+{
+    return failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * Header of a message received by the message_sink.
+ */
+struct Message
+{
+    std::string type;
+    std::string path;
+    std::string property;
+
+    bool operator==(const Message& other) const
+    {
+        return this->type == other.type && this->path == other.path
+               && this->property == other.property;
+    }
+
+    bool operator!=(const Message& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+inline Message parse_message(std::string_view msg)
+{
+    details::MessageHeader header;
+    details::parse_message_header(msg, header);
+    return Message{std::string(header.type),
+                   std::string(header.path),
+                   std::string(header.property)};
+}
+
+/**
+ * MessageLog stores the headers of the messages passed to a message_sink. The sink is called by
+ * the websocket thread, hence the log is protected by a mutex.
+ */
+class MessageLog
+{
+public:
+    void add(std::string_view msg)
+    {
+        const Message message = parse_message(msg);
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->messages_.push_back(message);
+    }
+
+    std::vector<Message> messages() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        return this->messages_;
+    }
+
+    /**
+     * Wait until the log contains a given number of messages.
+     * @return True if the messages are received before the timeout, false otherwise.
+     */
+    bool wait_for(std::size_t count,
+                  std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)) const
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            {
+                std::lock_guard<std::mutex> lock(this->mutex_);
+                if (this->messages_.size() >= count)
+                {
+                    return true;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<Message> messages_;
+};
+
+inline void print(const std::vector<Message>& messages)
+{
+    for (const auto& message : messages)
+    {
+        std::cerr << "  " << message.type << " " << message.path << " " << message.property
+                  << std::endl;
+    }
+}
+
+} // namespace MeshcatCpp::test
+
+#endif // MESHCAT_CPP_TEST_UTILS_H